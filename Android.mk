@@ -22,6 +22,7 @@ libminijailSrcFiles := \
 	libminijail.c \
 	signal_handler.c \
 	syscall_filter.c \
+	syscall_profile.c \
 	syscall_wrapper.c \
 	system.c \
 	util.c
@@ -87,6 +87,16 @@ extern void minijail_preexec(struct minijail *j);
  */
 extern void minijail_preenter(struct minijail *j);
 
+/* minijail_tmpfs_data: formats the mount(2) options for the /tmp of @j
+ * @j   jail whose tmpfs options to format
+ * @buf buffer to write them to
+ * @len size of @buf
+ *
+ * Returns 0 on success, -E2BIG if they don't fit in @buf.
+ */
+extern int minijail_tmpfs_data(const struct minijail *j, char *buf,
+                               size_t len);
+
 #ifdef __cplusplus
 }; /* extern "C" */
 #endif
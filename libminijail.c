@@ -8,11 +8,19 @@
 #define _GNU_SOURCE
 
 #include <asm/unistd.h>
+#include <ctype.h>
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <grp.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <malloc.h>
 #include <linux/capability.h>
+#include <linux/netlink.h>
+#include <linux/perf_event.h>
+#include <net/if.h>
+#include <poll.h>
 #include <pwd.h>
 #include <sched.h>
 #include <signal.h>
@@ -22,15 +30,19 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/capability.h>
+#include <sys/mman.h>
 #include <sys/mount.h>
 #include <sys/param.h>
 #include <sys/prctl.h>
 #include <sys/resource.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/user.h>
 #include <sys/wait.h>
 #include <syscall.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "libminijail.h"
@@ -38,6 +50,7 @@
 
 #include "signal_handler.h"
 #include "syscall_filter.h"
+#include "syscall_profile.h"
 #include "syscall_wrapper.h"
 #include "system.h"
 #include "util.h"
@@ -77,9 +90,31 @@
 
 #define MAX_RLIMITS 32 /* Currently there are 15 supported by Linux. */
 
+#define MAX_NUMA_NODES 1024 /* Largest CONFIG_NODES_SHIFT is 10. */
+
+#ifndef PR_SET_THP_DISABLE
+# define PR_SET_THP_DISABLE 41
+#endif
+
+#ifndef PR_SET_MEMORY_MERGE
+# define PR_SET_MEMORY_MERGE 67
+#endif
+
+/* I/O priorities, see ioprio_set(2). */
+#define IOPRIO_WHO_PROCESS 1
+#define IOPRIO_CLASS_SHIFT 13
+#define IOPRIO_PRIO_VALUE(class, data) \
+	(((class) << IOPRIO_CLASS_SHIFT) | (data))
+
+/* Highest utilization clamp value, see sched_setattr(2). */
+#define UCLAMP_MAX 1024
+
 /* Keyctl commands. */
 #define KEYCTL_JOIN_SESSION_KEYRING 1
 
+/* Where sd_notify(3) looks for the socket to send notifications to. */
+#define NOTIFY_SOCKET_ENV "NOTIFY_SOCKET"
+
 struct minijail_rlimit {
 	int type;
 	uint32_t cur;
@@ -96,6 +131,13 @@ struct mountpoint {
 	struct mountpoint *next;
 };
 
+struct hook {
+	minijail_hook_t hook;
+	void *context;
+	enum minijail_hook_event event;
+	struct hook *next;
+};
+
 struct minijail {
 	/*
 	 * WARNING: if you add a flag here you need to make sure it's
@@ -118,6 +160,7 @@ struct minijail {
 		int uts : 1;
 		int net : 1;
 		int enter_net : 1;
+		int enter_ipc : 1;
 		int ns_cgroups : 1;
 		int userns : 1;
 		int disable_setgroups : 1;
@@ -138,6 +181,24 @@ struct minijail {
 		int close_open_fds : 1;
 		int new_session_keyring : 1;
 		int forward_signals : 1;
+		int cgroup_v2 : 1;
+		int cpu_affinity : 1;
+		int sched_policy : 1;
+		int uclamp : 1;
+		int nice : 1;
+		int ioprio : 1;
+		int timerslack : 1;
+		int mempolicy : 1;
+		int thp : 1;
+		int oom_score_adj : 1;
+		int ksm : 1;
+		int counters : 1;
+		int syscall_profile : 1;
+		int veth : 1;
+		int veth_addrs : 1;
+		int notify_ready : 1;
+		int landlock : 1;
+		int dumpable : 1;
 	} flags;
 	uid_t uid;
 	gid_t gid;
@@ -148,8 +209,11 @@ struct minijail {
 	uint64_t caps;
 	uint64_t cap_bset;
 	pid_t initpid;
+	/* CLONE_NEW* namespaces that clone(2) already created for us. */
+	int clone_ns;
 	int mountns_fd;
 	int netns_fd;
+	int ipcns_fd;
 	char *chrootdir;
 	char *pid_file_path;
 	char *uidmap;
@@ -162,11 +226,51 @@ struct minijail {
 	struct mountpoint *mounts_tail;
 	size_t mounts_count;
 	size_t tmpfs_size;
+	size_t tmpfs_nr_inodes;
+	int tmpfs_huge;
+	int tmpfs_noswap;
+	int tmpfs_mpol_mode;
+	unsigned long tmpfs_node_mask[MAX_NUMA_NODES / (8 * sizeof(unsigned long))];
 	char *cgroups[MAX_CGROUPS];
 	size_t cgroup_count;
 	struct minijail_rlimit rlimits[MAX_RLIMITS];
 	size_t rlimit_count;
 	uint64_t securebits_skip_mask;
+	char *cgroup_parent;
+	char *cgroup_leaf;
+	uint64_t cgroup_cpu_quota;
+	uint64_t cgroup_cpu_period;
+	uint64_t cgroup_cpu_weight;
+	uint64_t cgroup_memory_high;
+	uint64_t cgroup_memory_max;
+	uint64_t cgroup_pids_max;
+	char *cgroup_io_max;
+	unsigned long cpu_mask[CPU_SETSIZE / (8 * sizeof(unsigned long))];
+	int sched_policy;
+	uint32_t uclamp_min;
+	uint32_t uclamp_max;
+	int nice;
+	int ioprio;
+	unsigned long timerslack_ns;
+	int mempolicy_mode;
+	unsigned long node_mask[MAX_NUMA_NODES / (8 * sizeof(unsigned long))];
+	int thp_enabled;
+	int oom_score_adj;
+	int dumpable;
+	int *counter_fds;
+	size_t counter_fd_count;
+	struct minijail_counters counters_prev;
+	struct syscall_profile *syscall_profile;
+	char veth_host[IFNAMSIZ];
+	char veth_jail[IFNAMSIZ];
+	struct in_addr veth_host_addr;
+	struct in_addr veth_jail_addr;
+	int veth_prefixlen;
+	int notify_fd;
+	char notify_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+	int landlock_fd;
+	struct hook *hooks_head;
+	struct hook *hooks_tail;
 };
 
 /*
@@ -184,7 +288,21 @@ void minijail_preenter(struct minijail *j)
 	j->flags.do_init = 0;
 	j->flags.pid_file = 0;
 	j->flags.cgroups = 0;
+	j->flags.cgroup_v2 = 0;
+	j->flags.oom_score_adj = 0;
+	j->flags.counters = 0;
+	j->flags.syscall_profile = 0;
+	/* The parent already set up the network namespace. */
+	if (j->flags.veth)
+		j->flags.net = 0;
+	j->flags.veth = 0;
+	/* Namespaces are entered before execve(2), with O_CLOEXEC fds. */
+	j->flags.enter_net = 0;
+	j->flags.enter_ipc = 0;
 	j->flags.forward_signals = 0;
+	j->flags.notify_ready = 0;
+	/* Landlock is in place before execve(2), and its fd is gone. */
+	j->flags.landlock = 0;
 }
 
 /*
@@ -198,6 +316,9 @@ void minijail_preexec(struct minijail *j)
 	int skip_remount_private = j->flags.skip_remount_private;
 	int remount_proc_ro = j->flags.remount_proc_ro;
 	int userns = j->flags.userns;
+	int enter_net = j->flags.enter_net;
+	int enter_ipc = j->flags.enter_ipc;
+	int landlock = j->flags.landlock;
 	if (j->user)
 		free(j->user);
 	j->user = NULL;
@@ -211,6 +332,9 @@ void minijail_preexec(struct minijail *j)
 	j->flags.skip_remount_private = skip_remount_private;
 	j->flags.remount_proc_ro = remount_proc_ro;
 	j->flags.userns = userns;
+	j->flags.enter_net = enter_net;
+	j->flags.enter_ipc = enter_ipc;
+	j->flags.landlock = landlock;
 	/* Note, |pids| will already have been used before this call. */
 }
 
@@ -490,6 +614,227 @@ void API minijail_namespace_enter_net(struct minijail *j, const char *ns_path)
 	j->flags.enter_net = 1;
 }
 
+int API minijail_veth(struct minijail *j, const char *host_ifname,
+		      const char *jail_ifname)
+{
+	if (j->flags.enter_net)
+		return -EINVAL;
+	if (!host_ifname[0] || strlen(host_ifname) >= IFNAMSIZ ||
+	    !jail_ifname[0] || strlen(jail_ifname) >= IFNAMSIZ)
+		return -EINVAL;
+	strcpy(j->veth_host, host_ifname);
+	strcpy(j->veth_jail, jail_ifname);
+	j->flags.net = 1;
+	j->flags.veth = 1;
+	return 0;
+}
+
+int API minijail_veth_addrs(struct minijail *j, const char *host_addr,
+			    const char *jail_addr)
+{
+	struct in_addr host, jail;
+	int host_prefixlen, jail_prefixlen;
+
+	if (parse_ipv4_prefix(host_addr, &host, &host_prefixlen) ||
+	    parse_ipv4_prefix(jail_addr, &jail, &jail_prefixlen))
+		return -EINVAL;
+	/* Both ends sit on the same link. */
+	if (host_prefixlen != jail_prefixlen)
+		return -EINVAL;
+	j->veth_host_addr = host;
+	j->veth_jail_addr = jail;
+	j->veth_prefixlen = host_prefixlen;
+	j->flags.veth_addrs = 1;
+	return 0;
+}
+
+/*
+ * notify_sockaddr: Fills in @addr for the sd_notify(3) socket @path, where a
+ * leading '@' stands for the abstract namespace.
+ */
+static int notify_sockaddr(const char *path, struct sockaddr_un *addr,
+			   socklen_t *addrlen)
+{
+	size_t len = strlen(path);
+
+	if (!len || len >= sizeof(addr->sun_path))
+		return -EINVAL;
+	memset(addr, 0, sizeof(*addr));
+	addr->sun_family = AF_UNIX;
+	memcpy(addr->sun_path, path, len);
+	*addrlen = offsetof(struct sockaddr_un, sun_path) + len;
+	if (path[0] == '@')
+		addr->sun_path[0] = '\0';
+	else
+		*addrlen += 1;
+	return 0;
+}
+
+int API minijail_notify_socket(struct minijail *j, const char *path)
+{
+	struct sockaddr_un addr;
+	socklen_t addrlen;
+	int one = 1;
+	int fd, ret;
+
+	if (j->flags.notify_ready)
+		return -EINVAL;
+	ret = notify_sockaddr(path, &addr, &addrlen);
+	if (ret)
+		return ret;
+	/*
+	 * A socket left behind by an earlier run would make bind(2) fail, but
+	 * anything else at @path is most likely a typo, so leave it alone.
+	 */
+	if (path[0] != '@') {
+		struct stat st;
+
+		if (!lstat(path, &st)) {
+			if (!S_ISSOCK(st.st_mode))
+				return -EEXIST;
+			unlink(path);
+		}
+	}
+	fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return -errno;
+	/* Have the kernel say who sent what, see recv_jail_notification(). */
+	if (setsockopt(fd, SOL_SOCKET, SO_PASSCRED, &one, sizeof(one)) ||
+	    bind(fd, (struct sockaddr *)&addr, addrlen)) {
+		ret = -errno;
+		close(fd);
+		return ret;
+	}
+	strcpy(j->notify_path, path);
+	j->notify_fd = fd;
+	j->flags.notify_ready = 1;
+	return 0;
+}
+
+int API minijail_restrict_fs(struct minijail *j, const char *path,
+			     int access)
+{
+	int landlock_access = 0;
+
+	if (!access || (access & ~(MINIJAIL_FS_READ | MINIJAIL_FS_WRITE |
+				   MINIJAIL_FS_EXEC)))
+		return -EINVAL;
+	if (access & MINIJAIL_FS_READ)
+		landlock_access |= LANDLOCK_FS_READ;
+	if (access & MINIJAIL_FS_WRITE)
+		landlock_access |= LANDLOCK_FS_WRITE;
+	if (access & MINIJAIL_FS_EXEC)
+		landlock_access |= LANDLOCK_FS_EXEC;
+
+	if (!j->flags.landlock) {
+		int fd = open_landlock_ruleset();
+		if (fd == -EOPNOTSUPP) {
+			warn("Landlock not supported, not restricting access "
+			     "to '%s'", path);
+			return 0;
+		}
+		if (fd < 0)
+			return fd;
+		j->landlock_fd = fd;
+		j->flags.landlock = 1;
+	}
+	return landlock_allow_path(j->landlock_fd, path, landlock_access);
+}
+
+struct minijail_group {
+	int netns_fd;
+	int ipcns_fd;
+};
+
+/*
+ * new_namespace_fd: Creates a namespace of type @nstype, named @name in
+ * /proc/<pid>/ns, without staying in it: it is unshared on this thread,
+ * which then switches back.
+ *
+ * Returns an fd for the new namespace, or -1 with errno set.
+ */
+static int new_namespace_fd(int nstype, const char *name)
+{
+	char path[64];
+	int self_fd;
+	int ns_fd;
+
+	snprintf(path, sizeof(path), "/proc/thread-self/ns/%s", name);
+	self_fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (self_fd < 0)
+		return -1;
+	if (unshare(nstype)) {
+		close(self_fd);
+		return -1;
+	}
+	ns_fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (ns_fd >= 0 && nstype == CLONE_NEWNET)
+		config_net_loopback();
+	if (setns(self_fd, nstype))
+		pdie("failed to return to the original %s namespace", name);
+	close(self_fd);
+	return ns_fd;
+}
+
+struct minijail_group API *minijail_group_new(int namespaces)
+{
+	struct minijail_group *group;
+
+	if (!namespaces ||
+	    (namespaces & ~(MINIJAIL_GROUP_NET | MINIJAIL_GROUP_IPC))) {
+		errno = EINVAL;
+		return NULL;
+	}
+	group = malloc(sizeof(*group));
+	if (!group)
+		return NULL;
+	group->netns_fd = -1;
+	group->ipcns_fd = -1;
+
+	if (namespaces & MINIJAIL_GROUP_NET) {
+		group->netns_fd = new_namespace_fd(CLONE_NEWNET, "net");
+		if (group->netns_fd < 0)
+			goto error;
+	}
+	if (namespaces & MINIJAIL_GROUP_IPC) {
+		group->ipcns_fd = new_namespace_fd(CLONE_NEWIPC, "ipc");
+		if (group->ipcns_fd < 0)
+			goto error;
+	}
+	return group;
+
+error:
+	minijail_group_destroy(group);
+	return NULL;
+}
+
+int API minijail_group_add(struct minijail_group *group, struct minijail *j)
+{
+	if (group->netns_fd >= 0 && (j->flags.enter_net || j->flags.veth))
+		return -EINVAL;
+	if (group->ipcns_fd >= 0 && j->flags.enter_ipc)
+		return -EINVAL;
+
+	if (group->netns_fd >= 0) {
+		j->netns_fd = group->netns_fd;
+		j->flags.enter_net = 1;
+	}
+	if (group->ipcns_fd >= 0) {
+		j->ipcns_fd = group->ipcns_fd;
+		j->flags.enter_ipc = 1;
+	}
+	return 0;
+}
+
+void API minijail_group_destroy(struct minijail_group *group)
+{
+	if (group->netns_fd >= 0)
+		close(group->netns_fd);
+	if (group->ipcns_fd >= 0)
+		close(group->ipcns_fd);
+	free(group);
+}
+
 void API minijail_namespace_cgroups(struct minijail *j)
 {
 	j->flags.ns_cgroups = 1;
@@ -578,6 +923,16 @@ int API minijail_enter_pivot_root(struct minijail *j, const char *dir)
 	return 0;
 }
 
+int API minijail_has_root(const struct minijail *j)
+{
+	return !!(j->flags.chroot || j->flags.pivot_root);
+}
+
+int API minijail_has_mount_ns(const struct minijail *j)
+{
+	return !!j->flags.vfs;
+}
+
 char API *minijail_get_original_path(struct minijail *j,
 				     const char *path_inside_chroot)
 {
@@ -634,6 +989,96 @@ void API minijail_mount_tmp_size(struct minijail *j, size_t size)
 {
 	j->tmpfs_size = size;
 	j->flags.mount_tmp = 1;
+	/* As with minijail_mount(), keep the mount out of our namespace. */
+	minijail_namespace_vfs(j);
+}
+
+/* tmpfs huge= values, stored one-based so that 0 leaves the default. */
+static const char *const kTmpfsHugeModes[] = {
+	"never", "always", "within_size", "advise",
+};
+
+static const char *const kTmpfsMpolModes[] = {
+	[MINIJAIL_MPOL_PREFERRED] = "prefer",
+	[MINIJAIL_MPOL_BIND] = "bind",
+	[MINIJAIL_MPOL_INTERLEAVE] = "interleave",
+};
+
+int API minijail_mount_tmp_opts(struct minijail *j, size_t size,
+				const char *opts)
+{
+	unsigned long node_mask[ARRAY_SIZE(j->tmpfs_node_mask)];
+	size_t nr_inodes = 0;
+	int huge = 0, noswap = 0, mpol_mode = 0, in_nodes = 0;
+	char *copy, *cur, *opt;
+	size_t i;
+	int ret = 0;
+
+	memset(node_mask, 0, sizeof(node_mask));
+	copy = strdup(opts ? opts : "");
+	if (!copy)
+		return -ENOMEM;
+	cur = copy;
+	while (!ret && (opt = tokenize(&cur, ","))) {
+		/* As with tmpfs itself, commas in a node list don't split. */
+		if (in_nodes && isdigit(*opt)) {
+			unsigned long more[ARRAY_SIZE(node_mask)];
+
+			/* parse_bitmap_list() overwrites the whole mask. */
+			memset(more, 0, sizeof(more));
+			ret = parse_bitmap_list(more, MAX_NUMA_NODES, opt);
+			for (i = 0; i < ARRAY_SIZE(node_mask); i++)
+				node_mask[i] |= more[i];
+			continue;
+		}
+		in_nodes = 0;
+		if (!strncmp(opt, "huge=", 5)) {
+			ret = -EINVAL;
+			for (i = 0; i < ARRAY_SIZE(kTmpfsHugeModes); i++) {
+				if (!strcmp(opt + 5, kTmpfsHugeModes[i])) {
+					huge = i + 1;
+					ret = 0;
+				}
+			}
+		} else if (!strncmp(opt, "mpol=", 5)) {
+			char *nodes = strchr(opt + 5, ':');
+
+			ret = -EINVAL;
+			if (!nodes)
+				continue;
+			*nodes++ = '\0';
+			for (i = 1; i < ARRAY_SIZE(kTmpfsMpolModes); i++) {
+				if (!strcmp(opt + 5, kTmpfsMpolModes[i])) {
+					mpol_mode = i;
+					ret = 0;
+				}
+			}
+			if (ret)
+				continue;
+			memset(node_mask, 0, sizeof(node_mask));
+			ret = parse_bitmap_list(node_mask, MAX_NUMA_NODES, nodes);
+			in_nodes = 1;
+		} else if (!strncmp(opt, "nr_inodes=", 10)) {
+			ret = parse_size(&nr_inodes, opt + 10);
+			if (!ret && !nr_inodes)
+				ret = -EINVAL;
+		} else if (!strcmp(opt, "noswap")) {
+			noswap = 1;
+		} else {
+			ret = -EINVAL;
+		}
+	}
+	free(copy);
+	if (ret)
+		return ret;
+
+	j->tmpfs_huge = huge;
+	j->tmpfs_mpol_mode = mpol_mode;
+	memcpy(j->tmpfs_node_mask, node_mask, sizeof(node_mask));
+	j->tmpfs_nr_inodes = nr_inodes;
+	j->tmpfs_noswap = noswap;
+	minijail_mount_tmp_size(j, size);
+	return 0;
 }
 
 int API minijail_write_pid_file(struct minijail *j, const char *path)
@@ -657,125 +1102,677 @@ int API minijail_add_to_cgroup(struct minijail *j, const char *path)
 	return 0;
 }
 
-int API minijail_rlimit(struct minijail *j, int type, uint32_t cur,
-			uint32_t max)
+int API minijail_cgroup_v2_parent(struct minijail *j, const char *path)
 {
-	size_t i;
-
-	if (j->rlimit_count >= MAX_RLIMITS)
+	if (j->cgroup_parent)
+		return -EINVAL;
+	j->cgroup_parent = strdup(path);
+	if (!j->cgroup_parent)
 		return -ENOMEM;
-	/* It's an error if the caller sets the same rlimit multiple times. */
-	for (i = 0; i < j->rlimit_count; i++) {
-		if (j->rlimits[i].type == type)
-			return -EEXIST;
-	}
+	j->flags.cgroup_v2 = 1;
+	return 0;
+}
 
-	j->rlimits[j->rlimit_count].type = type;
-	j->rlimits[j->rlimit_count].cur = cur;
-	j->rlimits[j->rlimit_count].max = max;
-	j->rlimit_count++;
+int API minijail_cgroup_v2_cpu_max(struct minijail *j, uint64_t quota_us,
+				   uint64_t period_us)
+{
+	/*
+	 * The kernel only accepts periods between 1ms and 1s, and quotas of at
+	 * least 1ms.
+	 */
+	if (quota_us < 1000 || period_us < 1000 || period_us > 1000000)
+		return -EINVAL;
+	j->cgroup_cpu_quota = quota_us;
+	j->cgroup_cpu_period = period_us;
 	return 0;
 }
 
-int API minijail_forward_signals(struct minijail *j)
+int API minijail_cgroup_v2_cpu_weight(struct minijail *j, uint64_t weight)
 {
-	j->flags.forward_signals = 1;
+	if (weight < 1 || weight > 10000)
+		return -EINVAL;
+	j->cgroup_cpu_weight = weight;
 	return 0;
 }
 
-int API minijail_mount_with_data(struct minijail *j, const char *src,
-				 const char *dest, const char *type,
-				 unsigned long flags, const char *data)
+int API minijail_cgroup_v2_memory_high(struct minijail *j, uint64_t bytes)
 {
-	struct mountpoint *m;
+	if (bytes == 0)
+		return -EINVAL;
+	j->cgroup_memory_high = bytes;
+	return 0;
+}
 
-	if (*dest != '/')
+int API minijail_cgroup_v2_memory_max(struct minijail *j, uint64_t bytes)
+{
+	if (bytes == 0)
 		return -EINVAL;
-	m = calloc(1, sizeof(*m));
-	if (!m)
-		return -ENOMEM;
-	m->dest = strdup(dest);
-	if (!m->dest)
-		goto error;
-	m->src = strdup(src);
-	if (!m->src)
-		goto error;
-	m->type = strdup(type);
-	if (!m->type)
-		goto error;
-	if (data) {
-		m->data = strdup(data);
-		if (!m->data)
-			goto error;
-		m->has_data = 1;
+	j->cgroup_memory_max = bytes;
+	return 0;
+}
+
+int API minijail_cgroup_v2_io_max(struct minijail *j, const char *spec)
+{
+	char *io_max;
+
+	/* Each device gets its own line in io.max. */
+	if (*spec == '\0' || strchr(spec, '\n'))
+		return -EINVAL;
+	if (j->cgroup_io_max) {
+		if (asprintf(&io_max, "%s\n%s", j->cgroup_io_max, spec) < 0)
+			return -ENOMEM;
+	} else {
+		io_max = strdup(spec);
+		if (!io_max)
+			return -ENOMEM;
 	}
-	m->flags = flags;
+	free(j->cgroup_io_max);
+	j->cgroup_io_max = io_max;
+	return 0;
+}
 
-	info("mount %s -> %s type '%s'", src, dest, type);
+int API minijail_cgroup_v2_pids_max(struct minijail *j, uint64_t max)
+{
+	if (max == 0)
+		return -EINVAL;
+	j->cgroup_pids_max = max;
+	return 0;
+}
 
-	/*
-	 * Force vfs namespacing so the mounts don't leak out into the
-	 * containing vfs namespace.
-	 */
-	minijail_namespace_vfs(j);
+static const char *pressure_file(int resource)
+{
+	switch (resource) {
+	case MINIJAIL_PRESSURE_CPU:
+		return "cpu.pressure";
+	case MINIJAIL_PRESSURE_MEMORY:
+		return "memory.pressure";
+	case MINIJAIL_PRESSURE_IO:
+		return "io.pressure";
+	default:
+		return NULL;
+	}
+}
 
-	if (j->mounts_tail)
-		j->mounts_tail->next = m;
-	else
-		j->mounts_head = m;
-	j->mounts_tail = m;
-	j->mounts_count++;
+int API minijail_pressure_trigger(struct minijail *j, int resource, int full,
+				  uint64_t stall_us, uint64_t window_us)
+{
+	const char *name = pressure_file(resource);
+	char trigger[64];
 
-	return 0;
+	if (!name || !j->cgroup_leaf)
+		return -EINVAL;
+	/* The kernel accepts windows between 500ms and 10s. */
+	if (window_us < 500000 || window_us > 10000000 || stall_us == 0 ||
+	    stall_us > window_us)
+		return -EINVAL;
 
-error:
-	free(m->type);
-	free(m->src);
-	free(m->dest);
-	free(m);
-	return -ENOMEM;
+	snprintf(trigger, sizeof(trigger), "%s %" PRIu64 " %" PRIu64,
+		 full ? "full" : "some", stall_us, window_us);
+	return open_psi_trigger(j->cgroup_leaf, name, trigger);
 }
 
-int API minijail_mount(struct minijail *j, const char *src, const char *dest,
-		       const char *type, unsigned long flags)
+static int parse_pressure_line(const char *line,
+			       struct minijail_pressure_avgs *avgs)
 {
-	return minijail_mount_with_data(j, src, dest, type, flags, NULL);
+	if (sscanf(line, "%*s avg10=%lf avg60=%lf avg300=%lf total=%" SCNu64,
+		   &avgs->avg10, &avgs->avg60, &avgs->avg300,
+		   &avgs->total_us) != 4)
+		return -EINVAL;
+	return 0;
 }
 
-int API minijail_bind(struct minijail *j, const char *src, const char *dest,
-		      int writeable)
+int API minijail_pressure_snapshot(struct minijail *j, int resource,
+				   struct minijail_pressure *pressure)
 {
-	unsigned long flags = MS_BIND;
+	const char *name = pressure_file(resource);
+	char buf[256];
+	char *full;
+	int ret;
 
-	if (!writeable)
-		flags |= MS_RDONLY;
+	if (!name || !j->cgroup_leaf)
+		return -EINVAL;
+	ret = read_cgroup_file(j->cgroup_leaf, name, buf, sizeof(buf));
+	if (ret)
+		return ret;
 
-	return minijail_mount(j, src, dest, "", flags);
+	memset(pressure, 0, sizeof(*pressure));
+	if (parse_pressure_line(buf, &pressure->some))
+		return -EINVAL;
+	/* Older kernels don't report "full" for cpu.pressure. */
+	full = strstr(buf, "\nfull ");
+	if (full && parse_pressure_line(full + 1, &pressure->full))
+		return -EINVAL;
+	return 0;
 }
 
-static void clear_seccomp_options(struct minijail *j)
+int API minijail_set_cpu_affinity(struct minijail *j, const char *cpus)
 {
-	j->flags.seccomp_filter = 0;
-	j->flags.seccomp_filter_tsync = 0;
-	j->flags.seccomp_filter_logging = 0;
-	j->filter_len = 0;
-	j->filter_prog = NULL;
-	j->flags.no_new_privs = 0;
+	int ret;
+
+	memset(j->cpu_mask, 0, sizeof(j->cpu_mask));
+	ret = parse_bitmap_list(j->cpu_mask, CPU_SETSIZE, cpus);
+	if (ret)
+		return ret;
+	j->flags.cpu_affinity = 1;
+	return 0;
 }
 
-static int seccomp_should_parse_filters(struct minijail *j)
+int API minijail_set_sched_policy(struct minijail *j, int policy)
 {
-	if (prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, NULL) == -1) {
-		/*
-		 * |errno| will be set to EINVAL when seccomp has not been
-		 * compiled into the kernel. On certain platforms and kernel
-		 * versions this is not a fatal failure. In that case, and only
-		 * in that case, disable seccomp and skip loading the filters.
-		 */
-		if ((errno == EINVAL) && seccomp_can_softfail()) {
-			warn("not loading seccomp filters, seccomp filter not "
-			     "supported");
-			clear_seccomp_options(j);
+	/* Realtime policies are not supported. */
+	if (policy != SCHED_OTHER && policy != SCHED_BATCH &&
+	    policy != SCHED_IDLE)
+		return -EINVAL;
+	j->sched_policy = policy;
+	j->flags.sched_policy = 1;
+	return 0;
+}
+
+int API minijail_set_uclamp(struct minijail *j, uint32_t min, uint32_t max)
+{
+	if (min > max || max > UCLAMP_MAX)
+		return -EINVAL;
+	j->uclamp_min = min;
+	j->uclamp_max = max;
+	j->flags.uclamp = 1;
+	return 0;
+}
+
+int API minijail_set_nice(struct minijail *j, int nice)
+{
+	if (nice < -20 || nice > 19)
+		return -EINVAL;
+	j->nice = nice;
+	j->flags.nice = 1;
+	return 0;
+}
+
+int API minijail_set_ioprio(struct minijail *j, int ioclass, int level)
+{
+	if (ioclass < MINIJAIL_IOPRIO_CLASS_RT ||
+	    ioclass > MINIJAIL_IOPRIO_CLASS_IDLE || level < 0 || level > 7)
+		return -EINVAL;
+	j->ioprio = IOPRIO_PRIO_VALUE(ioclass, level);
+	j->flags.ioprio = 1;
+	return 0;
+}
+
+int API minijail_set_timerslack(struct minijail *j, unsigned long slack_ns)
+{
+	if (slack_ns == 0)
+		return -EINVAL;
+	j->timerslack_ns = slack_ns;
+	j->flags.timerslack = 1;
+	return 0;
+}
+
+int API minijail_set_mempolicy(struct minijail *j, int mode, const char *nodes)
+{
+	int ret;
+
+	if (mode != MINIJAIL_MPOL_PREFERRED && mode != MINIJAIL_MPOL_BIND &&
+	    mode != MINIJAIL_MPOL_INTERLEAVE)
+		return -EINVAL;
+	memset(j->node_mask, 0, sizeof(j->node_mask));
+	ret = parse_bitmap_list(j->node_mask, MAX_NUMA_NODES, nodes);
+	if (ret)
+		return ret;
+	j->mempolicy_mode = mode;
+	j->flags.mempolicy = 1;
+	return 0;
+}
+
+void API minijail_set_thp(struct minijail *j, int enabled)
+{
+	j->thp_enabled = enabled;
+	j->flags.thp = 1;
+}
+
+void API minijail_enable_ksm(struct minijail *j)
+{
+	j->flags.ksm = 1;
+}
+
+static int add_ksm_stat(pid_t pid, struct minijail_ksm_stat *stat)
+{
+	char path[32];
+	char name[32];
+	long long value;
+	FILE *fp;
+
+	snprintf(path, sizeof(path), "/proc/%d/ksm_stat", pid);
+	fp = fopen(path, "re");
+	if (!fp)
+		return -errno;
+	while (fscanf(fp, "%31s %lld", name, &value) == 2) {
+		if (!strcmp(name, "ksm_merging_pages"))
+			stat->merging_pages += value;
+		else if (!strcmp(name, "ksm_rmap_items"))
+			stat->rmap_items += value;
+		else if (!strcmp(name, "ksm_process_profit"))
+			stat->process_profit += value;
+	}
+	fclose(fp);
+	return 0;
+}
+
+int API minijail_ksm_stat(struct minijail *j, struct minijail_ksm_stat *stat)
+{
+	char path[PATH_MAX];
+	FILE *procs;
+	int pid;
+	int ret;
+
+	memset(stat, 0, sizeof(*stat));
+	if (!j->cgroup_leaf)
+		return add_ksm_stat(j->initpid, stat);
+
+	/* Sum up every process in the jail's cgroup. */
+	ret = snprintf(path, sizeof(path), "%s/cgroup.procs", j->cgroup_leaf);
+	if (ret < 0 || (size_t)ret >= sizeof(path))
+		return -ENAMETOOLONG;
+	procs = fopen(path, "re");
+	if (!procs)
+		return -errno;
+	while (fscanf(procs, "%d", &pid) == 1) {
+		/* Processes can exit while we walk the list. */
+		ret = add_ksm_stat(pid, stat);
+		if (ret && ret != -ENOENT)
+			break;
+		ret = 0;
+	}
+	fclose(procs);
+	return ret;
+}
+
+void API minijail_use_counters(struct minijail *j)
+{
+	j->flags.counters = 1;
+}
+
+int API minijail_read_counters(struct minijail *j,
+			       struct minijail_counters *counters,
+			       struct minijail_counters *delta)
+{
+	size_t per_counter;
+	size_t i;
+	int c;
+
+	if (!j->counter_fds)
+		return -EINVAL;
+
+	memset(counters, 0, sizeof(*counters));
+	per_counter = j->counter_fd_count / MINIJAIL_COUNTER_COUNT;
+	for (i = 0; i < j->counter_fd_count; i++) {
+		uint64_t value;
+		int fd = j->counter_fds[i];
+
+		c = i / per_counter;
+		if (fd < 0)
+			continue;
+		if (read_perf_counter(fd, &value))
+			continue;
+		counters->value[c] += value;
+		counters->valid |= 1U << c;
+	}
+
+	if (delta) {
+		memset(delta, 0, sizeof(*delta));
+		for (c = 0; c < MINIJAIL_COUNTER_COUNT; c++) {
+			if (!(counters->valid & (1U << c)))
+				continue;
+			delta->value[c] =
+			    counters->value[c] - j->counters_prev.value[c];
+			delta->valid |= 1U << c;
+		}
+	}
+	j->counters_prev = *counters;
+	return 0;
+}
+
+void API minijail_profile_syscalls(struct minijail *j)
+{
+	j->flags.syscall_profile = 1;
+}
+
+int API minijail_dump_syscall_profile(struct minijail *j, int fd, int latency)
+{
+	if (!j->syscall_profile)
+		return -EINVAL;
+	return syscall_profile_dump(j->syscall_profile, fd, latency);
+}
+
+int API minijail_set_oom_score_adj(struct minijail *j, int adj)
+{
+	if (adj < -1000 || adj > 1000)
+		return -EINVAL;
+	j->oom_score_adj = adj;
+	j->flags.oom_score_adj = 1;
+	return 0;
+}
+
+void API minijail_set_dumpable(struct minijail *j, int dumpable)
+{
+	j->dumpable = !!dumpable;
+	j->flags.dumpable = 1;
+}
+
+int API minijail_set_core_limit(struct minijail *j, uint64_t bytes)
+{
+	/* Limits are kept in 32 bits. */
+	if (bytes > UINT32_MAX)
+		return -ERANGE;
+	return minijail_rlimit(j, RLIMIT_CORE, bytes, bytes);
+}
+
+int API minijail_rlimit(struct minijail *j, int type, uint32_t cur,
+			uint32_t max)
+{
+	size_t i;
+
+	if (j->rlimit_count >= MAX_RLIMITS)
+		return -ENOMEM;
+	/* It's an error if the caller sets the same rlimit multiple times. */
+	for (i = 0; i < j->rlimit_count; i++) {
+		if (j->rlimits[i].type == type)
+			return -EEXIST;
+	}
+
+	j->rlimits[j->rlimit_count].type = type;
+	j->rlimits[j->rlimit_count].cur = cur;
+	j->rlimits[j->rlimit_count].max = max;
+	j->rlimit_count++;
+	return 0;
+}
+
+int API minijail_forward_signals(struct minijail *j)
+{
+	j->flags.forward_signals = 1;
+	return 0;
+}
+
+int API minijail_mount_with_data(struct minijail *j, const char *src,
+				 const char *dest, const char *type,
+				 unsigned long flags, const char *data)
+{
+	struct mountpoint *m;
+
+	if (*dest != '/')
+		return -EINVAL;
+	m = calloc(1, sizeof(*m));
+	if (!m)
+		return -ENOMEM;
+	m->dest = strdup(dest);
+	if (!m->dest)
+		goto error;
+	m->src = strdup(src);
+	if (!m->src)
+		goto error;
+	m->type = strdup(type);
+	if (!m->type)
+		goto error;
+	if (data) {
+		m->data = strdup(data);
+		if (!m->data)
+			goto error;
+		m->has_data = 1;
+	}
+	m->flags = flags;
+
+	info("mount %s -> %s type '%s'", src, dest, type);
+
+	/*
+	 * Force vfs namespacing so the mounts don't leak out into the
+	 * containing vfs namespace.
+	 */
+	minijail_namespace_vfs(j);
+
+	if (j->mounts_tail)
+		j->mounts_tail->next = m;
+	else
+		j->mounts_head = m;
+	j->mounts_tail = m;
+	j->mounts_count++;
+
+	return 0;
+
+error:
+	free(m->type);
+	free(m->src);
+	free(m->dest);
+	free(m);
+	return -ENOMEM;
+}
+
+int API minijail_mount(struct minijail *j, const char *src, const char *dest,
+		       const char *type, unsigned long flags)
+{
+	return minijail_mount_with_data(j, src, dest, type, flags, NULL);
+}
+
+int API minijail_bind(struct minijail *j, const char *src, const char *dest,
+		      int writeable)
+{
+	unsigned long flags = MS_BIND;
+
+	if (!writeable)
+		flags |= MS_RDONLY;
+
+	return minijail_mount(j, src, dest, "", flags);
+}
+
+int API minijail_add_hook(struct minijail *j, minijail_hook_t hook,
+			  void *context, enum minijail_hook_event event)
+{
+	struct hook *h;
+
+	if (!hook || event < 0 || event >= MINIJAIL_HOOK_EVENT_MAX)
+		return -EINVAL;
+	h = calloc(1, sizeof(*h));
+	if (!h)
+		return -ENOMEM;
+	h->hook = hook;
+	h->context = context;
+	h->event = event;
+
+	if (j->hooks_tail)
+		j->hooks_tail->next = h;
+	else
+		j->hooks_head = h;
+	j->hooks_tail = h;
+
+	return 0;
+}
+
+static void free_mountpoint(struct mountpoint *m)
+{
+	free(m->data);
+	free(m->type);
+	free(m->dest);
+	free(m->src);
+	free(m);
+}
+
+static int mountpoints_equal(const struct mountpoint *a,
+			     const struct mountpoint *b)
+{
+	if (a->flags != b->flags || a->has_data != b->has_data)
+		return 0;
+	if (strcmp(a->src, b->src) || strcmp(a->dest, b->dest) ||
+	    strcmp(a->type, b->type))
+		return 0;
+	return !a->has_data || !strcmp(a->data, b->data);
+}
+
+struct mount_order {
+	struct mountpoint *m;
+	size_t index;
+};
+
+static int compare_mount_order(const void *pa, const void *pb)
+{
+	const struct mount_order *a = pa, *b = pb;
+	size_t depth_a = path_depth(a->m->dest);
+	size_t depth_b = path_depth(b->m->dest);
+	int ret;
+
+	if (depth_a != depth_b)
+		return depth_a < depth_b ? -1 : 1;
+	/* Group mounts on the same destination, keeping their order. */
+	ret = strcmp(a->m->dest, b->m->dest);
+	if (ret)
+		return ret;
+	return a->index < b->index ? -1 : 1;
+}
+
+/*
+ * Returns 1 if a mount after @a and before @b in the plan overlaps @b's
+ * destination, so that dropping @b would change what ends up visible there.
+ */
+static int mount_overlaps_between(const struct mountpoint *a,
+				  const struct mountpoint *b)
+{
+	const struct mountpoint *m;
+
+	for (m = a->next; m && m != b; m = m->next) {
+		if (path_under(m->dest, b->dest) || path_under(b->dest, m->dest))
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ * Returns 1 if bind mount @b, which comes after @a in the plan, only exposes
+ * what the recursive bind @a already made visible at the same place. @b has to
+ * be recursive too, or it would hide the mounts beneath it.
+ */
+static int bind_is_redundant(const struct mountpoint *a,
+			     const struct mountpoint *b)
+{
+	const char *dest_rest, *src_rest;
+
+	if ((a->flags & (MS_BIND | MS_REC)) != (MS_BIND | MS_REC))
+		return 0;
+	if (b->flags != a->flags || (b->flags & MS_REMOUNT))
+		return 0;
+	dest_rest = path_under(a->dest, b->dest);
+	src_rest = path_under(a->src, b->src);
+	return dest_rest && src_rest && !strcmp(dest_rest, src_rest);
+}
+
+int API minijail_optimize_mounts(struct minijail *j)
+{
+	struct mount_order *order;
+	struct mountpoint *m, *prev, *a;
+	size_t i, count = 0;
+	int removed = 0;
+
+	for (m = j->mounts_head; m; m = m->next)
+		count++;
+	if (count < 2)
+		return 0;
+
+	/* Parents before children, so nothing gets shadowed by accident. */
+	order = calloc(count, sizeof(*order));
+	if (!order)
+		return -ENOMEM;
+	for (i = 0, m = j->mounts_head; m; i++, m = m->next) {
+		order[i].m = m;
+		order[i].index = i;
+	}
+	qsort(order, count, sizeof(*order), compare_mount_order);
+	for (i = 0; i + 1 < count; i++)
+		order[i].m->next = order[i + 1].m;
+	order[count - 1].m->next = NULL;
+	j->mounts_head = order[0].m;
+	free(order);
+
+	prev = NULL;
+	m = j->mounts_head;
+	while (m) {
+		struct mountpoint *next = m->next;
+		const char *why = NULL;
+
+		for (a = j->mounts_head; a != m && !why; a = a->next) {
+			if (mount_overlaps_between(a, m))
+				continue;
+			if (mountpoints_equal(a, m))
+				why = "duplicate";
+			else if (bind_is_redundant(a, m))
+				why = "covered by recursive bind";
+		}
+
+		/*
+		 * A bind remount replaces all per-mount flags, so it makes an
+		 * earlier remount of the same bind moot, and a read-only
+		 * remount can ride on the R/O handling of the bind itself.
+		 */
+		if (!why && next && !strcmp(m->dest, next->dest) &&
+		    (next->flags & (MS_BIND | MS_REMOUNT)) ==
+			(MS_BIND | MS_REMOUNT)) {
+			unsigned long other = next->flags &
+					      ~(MS_BIND | MS_REMOUNT |
+						MS_RDONLY | MS_REC);
+
+			if ((m->flags & (MS_BIND | MS_REMOUNT)) ==
+			    (MS_BIND | MS_REMOUNT)) {
+				why = "superseded by later remount";
+			} else if ((m->flags & MS_BIND) && !other &&
+				   !next->has_data) {
+				m->flags = (m->flags & ~MS_RDONLY) |
+					   (next->flags & MS_RDONLY);
+				info("merged remount of %s into its bind",
+				     next->dest);
+				m->next = next->next;
+				free_mountpoint(next);
+				removed++;
+				/* Look at the new neighbour too. */
+				continue;
+			}
+		}
+
+		if (why) {
+			info("dropped mount %s -> %s: %s", m->src, m->dest,
+			     why);
+			if (prev)
+				prev->next = next;
+			else
+				j->mounts_head = next;
+			free_mountpoint(m);
+			removed++;
+		} else {
+			prev = m;
+		}
+		m = next;
+	}
+	j->mounts_tail = prev;
+	j->mounts_count -= removed;
+	return removed;
+}
+
+static void clear_seccomp_options(struct minijail *j)
+{
+	j->flags.seccomp_filter = 0;
+	j->flags.seccomp_filter_tsync = 0;
+	j->flags.seccomp_filter_logging = 0;
+	j->filter_len = 0;
+	j->filter_prog = NULL;
+	j->flags.no_new_privs = 0;
+}
+
+static int seccomp_should_parse_filters(struct minijail *j)
+{
+	if (prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, NULL) == -1) {
+		/*
+		 * |errno| will be set to EINVAL when seccomp has not been
+		 * compiled into the kernel. On certain platforms and kernel
+		 * versions this is not a fatal failure. In that case, and only
+		 * in that case, disable seccomp and skip loading the filters.
+		 */
+		if ((errno == EINVAL) && seccomp_can_softfail()) {
+			warn("not loading seccomp filters, seccomp filter not "
+			     "supported");
+			clear_seccomp_options(j);
 			return 0;
 		}
 		/*
@@ -941,6 +1938,14 @@ void minijail_marshal_helper(struct marshal_state *state,
 	}
 	for (i = 0; i < j->cgroup_count; ++i)
 		marshal_append(state, j->cgroups[i], strlen(j->cgroups[i]) + 1);
+	if (j->cgroup_parent) {
+		marshal_append(state, j->cgroup_parent,
+			       strlen(j->cgroup_parent) + 1);
+	}
+	if (j->cgroup_io_max) {
+		marshal_append(state, j->cgroup_io_max,
+			       strlen(j->cgroup_io_max) + 1);
+	}
 }
 
 size_t API minijail_size(const struct minijail *j)
@@ -978,6 +1983,12 @@ int minijail_unmarshal(struct minijail *j, char *serialized, size_t length)
 	j->mounts_head = NULL;
 	j->mounts_tail = NULL;
 	j->filter_prog = NULL;
+	j->cgroup_leaf = NULL;
+	j->counter_fds = NULL;
+	j->counter_fd_count = 0;
+	j->syscall_profile = NULL;
+	j->hooks_head = NULL;
+	j->hooks_tail = NULL;
 
 	if (j->user) {		/* stale pointer */
 		char *user = consumestr(&serialized, &length);
@@ -1100,17 +2111,35 @@ int minijail_unmarshal(struct minijail *j, char *serialized, size_t length)
 		++j->cgroup_count;
 	}
 
+	if (j->cgroup_parent) {	/* stale pointer */
+		char *cgroup_parent = consumestr(&serialized, &length);
+		if (!cgroup_parent)
+			goto bad_cgroup_parent;
+		j->cgroup_parent = strdup(cgroup_parent);
+		if (!j->cgroup_parent)
+			goto bad_cgroup_parent;
+	}
+
+	if (j->cgroup_io_max) {	/* stale pointer */
+		char *cgroup_io_max = consumestr(&serialized, &length);
+		if (!cgroup_io_max)
+			goto bad_cgroup_io_max;
+		j->cgroup_io_max = strdup(cgroup_io_max);
+		if (!j->cgroup_io_max)
+			goto bad_cgroup_io_max;
+	}
+
 	return 0;
 
+bad_cgroup_io_max:
+	if (j->cgroup_parent)
+		free(j->cgroup_parent);
+bad_cgroup_parent:
 bad_cgroups:
 	while (j->mounts_head) {
 		struct mountpoint *m = j->mounts_head;
 		j->mounts_head = j->mounts_head->next;
-		free(m->data);
-		free(m->type);
-		free(m->dest);
-		free(m->src);
-		free(m);
+		free_mountpoint(m);
 	}
 	for (i = 0; i < j->cgroup_count; ++i)
 		free(j->cgroups[i]);
@@ -1144,6 +2173,8 @@ clear_pointers:
 	j->hostname = NULL;
 	j->alt_syscall_table = NULL;
 	j->cgroup_count = 0;
+	j->cgroup_parent = NULL;
+	j->cgroup_io_max = NULL;
 out:
 	return ret;
 }
@@ -1278,19 +2309,41 @@ static int enter_pivot_root(const struct minijail *j)
 	return 0;
 }
 
-static int mount_tmp(const struct minijail *j)
+int minijail_tmpfs_data(const struct minijail *j, char *buf, size_t len)
 {
-	const char fmt[] = "size=%zu,mode=1777";
-	/* Count for the user storing ULLONG_MAX literally + extra space. */
-	char data[sizeof(fmt) + sizeof("18446744073709551615ULL")];
+	size_t used;
 	int ret;
 
-	ret = snprintf(data, sizeof(data), fmt, j->tmpfs_size);
-
+	ret = snprintf(buf, len, "size=%zu,mode=1777", j->tmpfs_size);
 	if (ret <= 0)
-		pdie("tmpfs size spec error");
-	else if ((size_t)ret >= sizeof(data))
-		pdie("tmpfs size spec too large");
+		return -E2BIG;
+	used = ret;
+	if (j->tmpfs_huge && used < len)
+		used += snprintf(buf + used, len - used, ",huge=%s",
+				 kTmpfsHugeModes[j->tmpfs_huge - 1]);
+	if (j->tmpfs_nr_inodes && used < len)
+		used += snprintf(buf + used, len - used, ",nr_inodes=%zu",
+				 j->tmpfs_nr_inodes);
+	if (j->tmpfs_noswap && used < len)
+		used += snprintf(buf + used, len - used, ",noswap");
+	if (j->tmpfs_mpol_mode && used < len) {
+		used += snprintf(buf + used, len - used, ",mpol=%s:",
+				 kTmpfsMpolModes[j->tmpfs_mpol_mode]);
+		if (used < len &&
+		    format_bitmap_list(buf + used, len - used,
+				       j->tmpfs_node_mask, MAX_NUMA_NODES))
+			used = len;
+	}
+	return used < len ? 0 : -E2BIG;
+}
+
+static int mount_tmp(const struct minijail *j)
+{
+	/* mount(2) copies at most a page of options. */
+	char data[4096];
+
+	if (minijail_tmpfs_data(j, data, sizeof(data)))
+		pdie("tmpfs options too large");
 	return mount("none", "/tmp", "tmpfs", MS_NODEV | MS_NOEXEC | MS_NOSUID,
 		     data);
 }
@@ -1315,34 +2368,328 @@ static int remount_proc_readonly(const struct minijail *j)
 			info("umount(/proc, MNT_DETACH) failed, "
 			     "this is expected when using user namespaces");
 		} else {
-			return -errno;
+			return -errno;
+		}
+	}
+	if (mount("proc", kProcPath, "proc", kSafeFlags | MS_RDONLY, ""))
+		return -errno;
+	return 0;
+}
+
+static void kill_child_and_die(const struct minijail *j, const char *msg)
+{
+	kill(j->initpid, SIGKILL);
+	die("%s", msg);
+}
+
+static void write_pid_file_or_die(const struct minijail *j)
+{
+	if (write_pid_to_path(j->initpid, j->pid_file_path))
+		kill_child_and_die(j, "failed to write pid file");
+}
+
+static void add_to_cgroups_or_die(const struct minijail *j)
+{
+	size_t i;
+
+	for (i = 0; i < j->cgroup_count; ++i) {
+		if (write_pid_to_path(j->initpid, j->cgroups[i]))
+			kill_child_and_die(j, "failed to add to cgroups");
+	}
+}
+
+static void cgroup_v2_leaf_die(const struct minijail *j, const char *msg)
+{
+	/* The child has not been moved in yet, so the leaf is still empty. */
+	rmdir(j->cgroup_leaf);
+	kill_child_and_die(j, msg);
+}
+
+static void set_cgroup_v2_limit_or_die(const struct minijail *j,
+				       const char *name, uint64_t value)
+{
+	char buf[32];
+
+	snprintf(buf, sizeof(buf), "%" PRIu64, value);
+	if (write_cgroup_file(j->cgroup_leaf, name, buf))
+		cgroup_v2_leaf_die(j, "failed to set cgroup limit");
+}
+
+static void set_cgroup_v2_cpuset_or_die(const struct minijail *j,
+					const char *name,
+					const unsigned long *mask,
+					size_t nbits)
+{
+	char list[4096];
+
+	if (format_bitmap_list(list, sizeof(list), mask, nbits))
+		cgroup_v2_leaf_die(j, "cpuset list too long");
+	if (write_cgroup_file(j->cgroup_leaf, name, list))
+		cgroup_v2_leaf_die(j, "failed to set cpuset");
+}
+
+/*
+ * create_cgroup_v2_leaf_or_die: Creates a cgroup for the jail below the
+ * configured cgroup v2 parent, applies the configured resource limits and
+ * moves the jailed process into it. The leaf is removed once the jail exits.
+ */
+static void create_cgroup_v2_leaf_or_die(struct minijail *j)
+{
+	char controllers[sizeof(" +cpu +cpuset +memory +io +pids")] = "";
+	int bind_mems =
+	    j->flags.mempolicy && j->mempolicy_mode == MINIJAIL_MPOL_BIND;
+	char buf[64];
+
+	free(j->cgroup_leaf);
+	if (asprintf(&j->cgroup_leaf, "%s/minijail-%d", j->cgroup_parent,
+		     j->initpid) < 0) {
+		j->cgroup_leaf = NULL;
+		kill_child_and_die(j, "failed to build cgroup path");
+	}
+	if (mkdir(j->cgroup_leaf, 0755)) {
+		pwarn("mkdir(%s) failed", j->cgroup_leaf);
+		free(j->cgroup_leaf);
+		j->cgroup_leaf = NULL;
+		kill_child_and_die(j, "failed to create cgroup");
+	}
+
+	/* The parent has to delegate controllers before the leaf can use them. */
+	if (j->cgroup_cpu_quota || j->cgroup_cpu_weight)
+		strcat(controllers, " +cpu");
+	if (j->flags.cpu_affinity || bind_mems)
+		strcat(controllers, " +cpuset");
+	if (j->cgroup_memory_high || j->cgroup_memory_max)
+		strcat(controllers, " +memory");
+	if (j->cgroup_io_max)
+		strcat(controllers, " +io");
+	if (j->cgroup_pids_max)
+		strcat(controllers, " +pids");
+	if (controllers[0] && write_cgroup_file(j->cgroup_parent,
+						"cgroup.subtree_control",
+						controllers + 1)) {
+		cgroup_v2_leaf_die(j, "failed to enable cgroup controllers");
+	}
+
+	if (j->cgroup_cpu_quota) {
+		snprintf(buf, sizeof(buf), "%" PRIu64 " %" PRIu64,
+			 j->cgroup_cpu_quota, j->cgroup_cpu_period);
+		if (write_cgroup_file(j->cgroup_leaf, "cpu.max", buf))
+			cgroup_v2_leaf_die(j, "failed to set cpu.max");
+	}
+	if (j->cgroup_cpu_weight)
+		set_cgroup_v2_limit_or_die(j, "cpu.weight",
+					   j->cgroup_cpu_weight);
+	/*
+	 * Mirror CPU affinity and a bound memory policy in the cpuset, so that
+	 * the placement also holds for anything the jail forks off.
+	 */
+	if (j->flags.cpu_affinity)
+		set_cgroup_v2_cpuset_or_die(j, "cpuset.cpus", j->cpu_mask,
+					    CPU_SETSIZE);
+	if (bind_mems)
+		set_cgroup_v2_cpuset_or_die(j, "cpuset.mems", j->node_mask,
+					    MAX_NUMA_NODES);
+	if (j->cgroup_memory_high)
+		set_cgroup_v2_limit_or_die(j, "memory.high",
+					   j->cgroup_memory_high);
+	if (j->cgroup_memory_max)
+		set_cgroup_v2_limit_or_die(j, "memory.max",
+					   j->cgroup_memory_max);
+	if (j->cgroup_pids_max)
+		set_cgroup_v2_limit_or_die(j, "pids.max", j->cgroup_pids_max);
+	if (j->cgroup_io_max) {
+		/* io.max takes a single device per write(2). */
+		char *io_max = strdup(j->cgroup_io_max);
+		char *pos = io_max;
+		char *line;
+		if (!io_max)
+			cgroup_v2_leaf_die(j, "failed to copy io.max spec");
+		while ((line = tokenize(&pos, "\n")) != NULL) {
+			if (write_cgroup_file(j->cgroup_leaf, "io.max", line))
+				cgroup_v2_leaf_die(j, "failed to set io.max");
+		}
+		free(io_max);
+	}
+
+	snprintf(buf, sizeof(buf), "%d", j->initpid);
+	if (write_cgroup_file(j->cgroup_leaf, "cgroup.procs", buf))
+		cgroup_v2_leaf_die(j, "failed to add to cgroup");
+}
+
+/*
+ * remove_cgroup_v2_leaf: Removes the per-jail cgroup once the jail is gone.
+ * Without a pid namespace, descendants of the jailed process can outlive it and
+ * keep the cgroup populated, in which case it is left behind.
+ */
+static void remove_cgroup_v2_leaf(struct minijail *j)
+{
+	if (!j->cgroup_leaf)
+		return;
+	if (rmdir(j->cgroup_leaf))
+		pwarn("failed to remove cgroup '%s'", j->cgroup_leaf);
+	free(j->cgroup_leaf);
+	j->cgroup_leaf = NULL;
+}
+
+static void close_counters(struct minijail *j)
+{
+	size_t i;
+
+	for (i = 0; i < j->counter_fd_count; i++) {
+		if (j->counter_fds[i] >= 0)
+			close(j->counter_fds[i]);
+	}
+	free(j->counter_fds);
+	j->counter_fds = NULL;
+	j->counter_fd_count = 0;
+}
+
+/*
+ * open_counters: Opens the counters from minijail_use_counters(). They count
+ * the jail's cgroup on every CPU if it has one, or follow the init process
+ * and its descendants otherwise. Counters the kernel or hardware cannot
+ * provide are left out; the jail runs either way.
+ */
+static void open_counters(struct minijail *j)
+{
+	static const struct {
+		uint32_t type;
+		uint64_t config;
+	} events[MINIJAIL_COUNTER_COUNT] = {
+		[MINIJAIL_COUNTER_CYCLES] =
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		[MINIJAIL_COUNTER_INSTRUCTIONS] =
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		[MINIJAIL_COUNTER_CACHE_MISSES] =
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		[MINIJAIL_COUNTER_CONTEXT_SWITCHES] =
+			{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+		[MINIJAIL_COUNTER_PAGE_FAULTS] =
+			{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+	};
+	int cgroup_fd = -1;
+	size_t per_counter = 1;
+	size_t opened = 0;
+	size_t i;
+
+	/* Running the jail again starts counting afresh. */
+	close_counters(j);
+	memset(&j->counters_prev, 0, sizeof(j->counters_prev));
+
+	if (j->cgroup_leaf) {
+		long cpus = sysconf(_SC_NPROCESSORS_CONF);
+		cgroup_fd = open(j->cgroup_leaf,
+				 O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (cgroup_fd < 0 || cpus <= 0) {
+			pwarn("failed to open cgroup '%s' for counters",
+			      j->cgroup_leaf);
+			if (cgroup_fd >= 0)
+				close(cgroup_fd);
+			cgroup_fd = -1;
+		} else {
+			per_counter = cpus;
 		}
 	}
-	if (mount("proc", kProcPath, "proc", kSafeFlags | MS_RDONLY, ""))
-		return -errno;
-	return 0;
+
+	j->counter_fd_count = MINIJAIL_COUNTER_COUNT * per_counter;
+	j->counter_fds = calloc(j->counter_fd_count, sizeof(int));
+	if (!j->counter_fds) {
+		j->counter_fd_count = 0;
+		goto out;
+	}
+	for (i = 0; i < j->counter_fd_count; i++) {
+		size_t c = i / per_counter;
+		int fd = open_perf_counter(events[c].type, events[c].config,
+					   j->initpid, i % per_counter,
+					   cgroup_fd);
+		/* Offline CPUs and missing PMUs are expected. */
+		j->counter_fds[i] = fd < 0 ? -1 : fd;
+		if (fd >= 0)
+			opened++;
+	}
+	if (!opened)
+		warn("no performance counters available for the jail");
+
+out:
+	if (cgroup_fd >= 0)
+		close(cgroup_fd);
 }
 
-static void kill_child_and_die(const struct minijail *j, const char *msg)
+/*
+ * start_syscall_profile: Profiles the jail's cgroup from
+ * minijail_profile_syscalls(). Like counters, profiling is best-effort.
+ */
+static void start_syscall_profile(struct minijail *j)
 {
-	kill(j->initpid, SIGKILL);
-	die("%s", msg);
+	if (!j->cgroup_leaf) {
+		warn("syscall profiling needs a cgroup, not profiling");
+		return;
+	}
+	j->syscall_profile = syscall_profile_start(j->cgroup_leaf);
 }
 
-static void write_pid_file_or_die(const struct minijail *j)
+/*
+ * setup_veth_or_die: Plumbs the jail's network namespace, created along with
+ * the child, to the parent's with the veth pair from minijail_veth().
+ */
+static void setup_veth_or_die(const struct minijail *j)
 {
-	if (write_pid_to_path(j->initpid, j->pid_file_path))
-		kill_child_and_die(j, "failed to write pid file");
+	struct veth_config cfg = {
+		.host_ifname = j->veth_host,
+		.jail_ifname = j->veth_jail,
+		.has_addrs = j->flags.veth_addrs,
+		.host_addr = j->veth_host_addr,
+		.jail_addr = j->veth_jail_addr,
+		.prefixlen = j->veth_prefixlen,
+	};
+	char path[32];
+	int self_fd;
+	int host_sock;
+	int jail_sock;
+	int ret;
+
+	snprintf(path, sizeof(path), "/proc/%d/ns/net", j->initpid);
+	cfg.netns_fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (cfg.netns_fd < 0)
+		kill_child_and_die(j, "failed to open the jail's network "
+				      "namespace");
+	self_fd = open("/proc/thread-self/ns/net", O_RDONLY | O_CLOEXEC);
+	if (self_fd < 0)
+		kill_child_and_die(j, "failed to open the network namespace");
+
+	/* Netlink sockets stay in the namespace they were created in. */
+	host_sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+	if (host_sock < 0)
+		kill_child_and_die(j, "failed to open netlink socket");
+	if (setns(cfg.netns_fd, CLONE_NEWNET))
+		kill_child_and_die(j, "failed to enter the jail's network "
+				      "namespace");
+	jail_sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+	if (setns(self_fd, CLONE_NEWNET))
+		kill_child_and_die(j, "failed to return to the network "
+				      "namespace");
+	close(self_fd);
+	if (jail_sock < 0)
+		kill_child_and_die(j, "failed to open netlink socket");
+
+	ret = config_net_veth(host_sock, jail_sock, &cfg);
+	close(jail_sock);
+	close(host_sock);
+	close(cfg.netns_fd);
+	if (ret) {
+		kill(j->initpid, SIGKILL);
+		die("failed to set up veth pair '%s': %s", j->veth_host,
+		    strerror(-ret));
+	}
 }
 
-static void add_to_cgroups_or_die(const struct minijail *j)
+static void write_oom_score_adj_or_die(const struct minijail *j)
 {
-	size_t i;
+	char buf[16];
 
-	for (i = 0; i < j->cgroup_count; ++i) {
-		if (write_pid_to_path(j->initpid, j->cgroups[i]))
-			kill_child_and_die(j, "failed to add to cgroups");
-	}
+	snprintf(buf, sizeof(buf), "%d", j->oom_score_adj);
+	if (write_proc_file(j->initpid, buf, "oom_score_adj"))
+		kill_child_and_die(j, "failed to write oom_score_adj");
 }
 
 static void set_rlimits_or_die(const struct minijail *j)
@@ -1407,6 +2754,62 @@ static void wait_for_parent_setup(int *pipe_fds)
 	close(pipe_fds[0]);
 }
 
+/*
+ * set_scheduling: Applies CPU placement and scheduling attributes. Raising
+ * priorities needs CAP_SYS_NICE, so this runs before privileges are dropped.
+ */
+static void set_scheduling(const struct minijail *j)
+{
+	if (j->flags.cpu_affinity &&
+	    sched_setaffinity(0, sizeof(j->cpu_mask),
+			      (const cpu_set_t *)j->cpu_mask)) {
+		pdie("sched_setaffinity() failed");
+	}
+
+	if (j->flags.sched_policy || j->flags.uclamp) {
+		int ret = set_sched_attr(
+		    j->flags.sched_policy ? j->sched_policy : -1,
+		    j->flags.uclamp, j->uclamp_min, j->uclamp_max);
+		if (ret) {
+			errno = -ret;
+			pdie("sched_setattr() failed");
+		}
+	}
+
+	if (j->flags.nice && setpriority(PRIO_PROCESS, 0, j->nice))
+		pdie("setpriority(%d) failed", j->nice);
+
+	if (j->flags.ioprio &&
+	    sys_ioprio_set(IOPRIO_WHO_PROCESS, 0, j->ioprio)) {
+		pdie("ioprio_set(%#x) failed", j->ioprio);
+	}
+
+	if (j->flags.timerslack && prctl(PR_SET_TIMERSLACK, j->timerslack_ns))
+		pdie("prctl(PR_SET_TIMERSLACK) failed");
+}
+
+static void set_memory_policy(const struct minijail *j)
+{
+	/* set_mempolicy(2) drops the last bit of |maxnode|. */
+	if (j->flags.mempolicy &&
+	    sys_set_mempolicy(j->mempolicy_mode, j->node_mask,
+			      MAX_NUMA_NODES + 1)) {
+		pdie("set_mempolicy() failed");
+	}
+
+	if (j->flags.thp &&
+	    prctl(PR_SET_THP_DISABLE, !j->thp_enabled, 0, 0, 0)) {
+		pdie("prctl(PR_SET_THP_DISABLE) failed");
+	}
+
+	/*
+	 * Process-wide KSM is inherited across fork(2) and execve(2). It's
+	 * only an optimization, so don't fail on kernels without it.
+	 */
+	if (j->flags.ksm && prctl(PR_SET_MEMORY_MERGE, 1, 0, 0, 0))
+		pwarn("prctl(PR_SET_MEMORY_MERGE) failed");
+}
+
 static void drop_ugid(const struct minijail *j)
 {
 	if (j->flags.inherit_suppl_gids + j->flags.keep_suppl_gids +
@@ -1632,6 +3035,116 @@ static void install_signal_handlers(void)
 	}
 }
 
+/*
+ * Changing uids and execve(2) reset the dumpable flag, so this comes last,
+ * after drop_ugid() and in the program itself.
+ */
+static void set_dumpable(const struct minijail *j)
+{
+	if (j->flags.dumpable && prctl(PR_SET_DUMPABLE, j->dumpable, 0, 0, 0))
+		pdie("prctl(PR_SET_DUMPABLE) failed");
+}
+
+static void run_hooks_or_die(const struct minijail *j,
+			     enum minijail_hook_event event)
+{
+	const struct hook *h;
+	int ret;
+
+	for (h = j->hooks_head; h; h = h->next) {
+		if (h->event != event)
+			continue;
+		ret = h->hook(h->context);
+		if (ret)
+			die("hook %d failed: %s", event, strerror(-ret));
+	}
+}
+
+/*
+ * clone_namespace_flags: Returns the CLONE_NEW* flags of every namespace the
+ * jail creates. Namespaces that are joined with setns(2) first are left to
+ * enter_namespaces(), and so is the cgroup namespace when the parent moves the
+ * child into cgroups, since its root is the cgroup it gets created in. Without
+ * clone(2), enter_namespaces() unshares these flags in one go.
+ */
+static int clone_namespace_flags(const struct minijail *j)
+{
+	int flags = 0;
+
+	if (j->flags.pids)
+		flags |= CLONE_NEWPID;
+	if (j->flags.userns)
+		flags |= CLONE_NEWUSER;
+	if (j->flags.vfs && !j->flags.enter_vfs)
+		flags |= CLONE_NEWNS;
+	if (j->flags.ipc && !j->flags.enter_ipc)
+		flags |= CLONE_NEWIPC;
+	if (j->flags.uts)
+		flags |= CLONE_NEWUTS;
+	if (j->flags.veth || (j->flags.net && !j->flags.enter_net))
+		flags |= CLONE_NEWNET;
+	if (j->flags.ns_cgroups && !j->flags.cgroups && !j->flags.cgroup_v2)
+		flags |= CLONE_NEWCGROUP;
+	return flags;
+}
+
+/*
+ * enter_namespaces: Joins the namespaces the jail shares, unshares the ones
+ * clone(2) didn't create in one go, then sets them up. Runs in the child
+ * before anything that depends on them.
+ */
+static void enter_namespaces(struct minijail *j)
+{
+	int unshare_ns;
+
+	/*
+	 * Join the network and IPC namespaces of the jail's group (see
+	 * minijail_group_add()), or the one from minijail_namespace_enter_net().
+	 */
+	if (j->flags.enter_net && setns(j->netns_fd, CLONE_NEWNET))
+		pdie("setns(CLONE_NEWNET) failed");
+	if (j->flags.enter_ipc && setns(j->ipcns_fd, CLONE_NEWIPC))
+		pdie("setns(CLONE_NEWIPC) failed");
+
+	if (j->flags.enter_vfs && setns(j->mountns_fd, CLONE_NEWNS))
+		pdie("setns(CLONE_NEWNS) failed");
+
+	/*
+	 * Create the namespaces clone(2) didn't with a single unshare(2): all
+	 * of them after fork(2), or just the cgroup namespace now that the
+	 * parent has moved us into our cgroups. A mount namespace that was
+	 * joined gets a private copy. User namespaces only come with clone(2),
+	 * since the parent has already written the id maps.
+	 */
+	unshare_ns = clone_namespace_flags(j) & ~CLONE_NEWUSER;
+	if (j->flags.enter_vfs && j->flags.vfs)
+		unshare_ns |= CLONE_NEWNS;
+	if (j->flags.ns_cgroups)
+		unshare_ns |= CLONE_NEWCGROUP;
+	unshare_ns &= ~j->clone_ns;
+	if (unshare_ns && unshare(unshare_ns))
+		pdie("unshare(%#x) failed", unshare_ns);
+	j->clone_ns |= unshare_ns;
+
+	/*
+	 * Unless asked not to, remount all filesystems as private. If they are
+	 * shared, new bind mounts will creep out of our namespace.
+	 * https://www.kernel.org/doc/Documentation/filesystems/sharedsubtree.txt
+	 */
+	if (j->flags.vfs && !j->flags.skip_remount_private) {
+		if (mount(NULL, "/", NULL, MS_REC | MS_PRIVATE, NULL))
+			pdie("mount(NULL, /, NULL, MS_REC | MS_PRIVATE, NULL) "
+			     "failed");
+	}
+
+	if (j->flags.uts && j->hostname &&
+	    sethostname(j->hostname, strlen(j->hostname)))
+		pdie("sethostname(%s) failed", j->hostname);
+
+	if (j->flags.net && !j->flags.enter_net)
+		config_net_loopback();
+}
+
 void API minijail_enter(const struct minijail *j)
 {
 #if 0
@@ -1654,51 +3167,9 @@ void API minijail_enter(const struct minijail *j)
 	/*
 	 * We can't recover from failures if we've dropped privileges partially,
 	 * so we don't even try. If any of our operations fail, we abort() the
-	 * entire process.
+	 * entire process. minijail_run*() already set up the namespaces, see
+	 * enter_namespaces().
 	 */
-	if (j->flags.enter_vfs && setns(j->mountns_fd, CLONE_NEWNS))
-		pdie("setns(CLONE_NEWNS) failed");
-
-	if (j->flags.vfs) {
-		if (unshare(CLONE_NEWNS))
-			pdie("unshare(CLONE_NEWNS) failed");
-		/*
-		 * Unless asked not to, remount all filesystems as private.
-		 * If they are shared, new bind mounts will creep out of our
-		 * namespace.
-		 * https://www.kernel.org/doc/Documentation/filesystems/sharedsubtree.txt
-		 */
-		if (!j->flags.skip_remount_private) {
-			if (mount(NULL, "/", NULL, MS_REC | MS_PRIVATE, NULL))
-				pdie("mount(NULL, /, NULL, MS_REC | MS_PRIVATE,"
-				     " NULL) failed");
-		}
-	}
-
-	if (j->flags.ipc && unshare(CLONE_NEWIPC)) {
-		pdie("unshare(CLONE_NEWIPC) failed");
-	}
-
-	if (j->flags.uts) {
-		if (unshare(CLONE_NEWUTS))
-			pdie("unshare(CLONE_NEWUTS) failed");
-
-		if (j->hostname && sethostname(j->hostname, strlen(j->hostname)))
-			pdie("sethostname(%s) failed", j->hostname);
-	}
-
-	if (j->flags.enter_net) {
-		if (setns(j->netns_fd, CLONE_NEWNET))
-			pdie("setns(CLONE_NEWNET) failed");
-	} else if (j->flags.net) {
-		if (unshare(CLONE_NEWNET))
-			pdie("unshare(CLONE_NEWNET) failed");
-		config_net_loopback();
-	}
-
-	if (j->flags.ns_cgroups && unshare(CLONE_NEWCGROUP))
-		pdie("unshare(CLONE_NEWCGROUP) failed");
-
 	if (j->flags.new_session_keyring) {
 		if (syscall(SYS_keyctl, KEYCTL_JOIN_SESSION_KEYRING, NULL) < 0)
 			pdie("keyctl(KEYCTL_JOIN_SESSION_KEYRING) failed");
@@ -1710,9 +3181,6 @@ void API minijail_enter(const struct minijail *j)
 	if (j->flags.pivot_root && enter_pivot_root(j))
 		pdie("pivot_root");
 
-	if (j->flags.mount_tmp && mount_tmp(j))
-		pdie("mount_tmp");
-
 	if (j->flags.remount_proc_ro && remount_proc_readonly(j))
 		pdie("remount");
 
@@ -1782,6 +3250,8 @@ void API minijail_enter(const struct minijail *j)
 		pdie("prctl(PR_SET_SECCOMP) failed");
 	}
 #endif
+
+	set_dumpable(j);
 }
 
 /* TODO(wad): will visibility affect this variable? */
@@ -1820,49 +3290,447 @@ int API minijail_from_fd(int fd, struct minijail *j)
 	int r;
 	if (sizeof(sz) != bytes)
 		return -EINVAL;
-	if (sz > USHRT_MAX)	/* arbitrary sanity check */
-		return -E2BIG;
-	buf = malloc(sz);
+	if (sz > USHRT_MAX)	/* arbitrary sanity check */
+		return -E2BIG;
+	buf = malloc(sz);
+	if (!buf)
+		return -ENOMEM;
+	bytes = read(fd, buf, sz);
+	if (bytes != sz) {
+		free(buf);
+		return -EINVAL;
+	}
+	r = minijail_unmarshal(j, buf, sz);
+	free(buf);
+	return r;
+}
+
+int API minijail_to_fd(struct minijail *j, int fd)
+{
+	char *buf;
+	size_t sz = minijail_size(j);
+	ssize_t written;
+	int r;
+
+	if (!sz)
+		return -EINVAL;
+	buf = malloc(sz);
+	r = minijail_marshal(j, buf, sz);
+	if (r) {
+		free(buf);
+		return r;
+	}
+	/* Sends [size][minijail]. */
+	written = write(fd, &sz, sizeof(sz));
+	if (written != sizeof(sz)) {
+		free(buf);
+		return -EFAULT;
+	}
+	written = write(fd, buf, sz);
+	if (written < 0 || (size_t) written != sz) {
+		free(buf);
+		return -EFAULT;
+	}
+	free(buf);
+	return 0;
+}
+
+/*
+ * Compiled profiles: [header][marshalled jail][parent-side strings].
+ * The marshalled jail is a copy of struct minijail, so profiles only load
+ * into the same build of the library that wrote them.
+ */
+#define PROFILE_MAGIC 0x504a494d /* "MIJP" */
+#define PROFILE_VERSION 1
+
+struct profile_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t jail_struct_size;
+	uint32_t jail_size;
+	uint32_t extra_size;
+};
+
+/* Paths and maps only the parent uses, which marshalling leaves out. */
+static const size_t profile_extra_offsets[] = {
+	offsetof(struct minijail, pid_file_path),
+	offsetof(struct minijail, uidmap),
+	offsetof(struct minijail, gidmap),
+};
+
+int API minijail_write_profile(const struct minijail *j, int fd)
+{
+	struct profile_header hdr = {
+		.magic = PROFILE_MAGIC,
+		.version = PROFILE_VERSION,
+		.jail_struct_size = sizeof(*j),
+	};
+	char *buf, *extra;
+	size_t jail_size;
+	size_t extra_size = 0;
+	size_t total;
+	size_t i;
+	ssize_t written;
+	int ret;
+
+	/*
+	 * Namespaces entered through fds, sockets, rulesets and hooks can't be
+	 * stored.
+	 */
+	if (j->flags.enter_vfs || j->flags.enter_net || j->flags.enter_ipc ||
+	    j->flags.notify_ready || j->flags.landlock || j->hooks_head)
+		return -EINVAL;
+
+	jail_size = minijail_size(j);
+	if (!jail_size || jail_size > UINT32_MAX)
+		return -EINVAL;
+	for (i = 0; i < ARRAY_SIZE(profile_extra_offsets); i++) {
+		const char *str = *(char *const *)((const char *)j +
+						     profile_extra_offsets[i]);
+		extra_size += (str ? strlen(str) : 0) + 1;
+	}
+
+	total = sizeof(hdr) + jail_size + extra_size;
+	buf = malloc(total);
+	if (!buf)
+		return -ENOMEM;
+	ret = minijail_marshal(j, buf + sizeof(hdr), jail_size);
+	if (ret) {
+		free(buf);
+		return ret;
+	}
+	/* An empty string stands for a NULL pointer. */
+	extra = buf + sizeof(hdr) + jail_size;
+	for (i = 0; i < ARRAY_SIZE(profile_extra_offsets); i++) {
+		const char *str = *(char *const *)((const char *)j +
+						     profile_extra_offsets[i]);
+		size_t len = str ? strlen(str) : 0;
+		memcpy(extra, str ? str : "", len + 1);
+		extra += len + 1;
+	}
+	hdr.jail_size = jail_size;
+	hdr.extra_size = extra_size;
+	memcpy(buf, &hdr, sizeof(hdr));
+
+	written = write(fd, buf, total);
+	free(buf);
+	if (written < 0)
+		return -errno;
+	if ((size_t)written != total)
+		return -EIO;
+	return 0;
+}
+
+int API minijail_read_profile(struct minijail *j, const char *path)
+{
+	struct profile_header hdr;
+	struct stat st;
+	char *base, *extra;
+	size_t extra_size;
+	size_t i;
+	int fd;
+	int ret;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+	if (fstat(fd, &st)) {
+		ret = -errno;
+		close(fd);
+		return ret;
+	}
+	if ((size_t)st.st_size < sizeof(hdr)) {
+		close(fd);
+		return -EINVAL;
+	}
+	base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+		return -errno;
+
+	ret = -EINVAL;
+	memcpy(&hdr, base, sizeof(hdr));
+	if (hdr.magic != PROFILE_MAGIC || hdr.version != PROFILE_VERSION ||
+	    hdr.jail_struct_size != sizeof(*j) ||
+	    (uint64_t)sizeof(hdr) + hdr.jail_size + hdr.extra_size !=
+		(uint64_t)st.st_size)
+		goto out;
+
+	/* Unmarshalling only reads from the buffer. */
+	ret = minijail_unmarshal(j, base + sizeof(hdr), hdr.jail_size);
+	if (ret)
+		goto out;
+
+	extra = base + sizeof(hdr) + hdr.jail_size;
+	extra_size = hdr.extra_size;
+	for (i = 0; i < ARRAY_SIZE(profile_extra_offsets); i++) {
+		char **field = (char **)((char *)j + profile_extra_offsets[i]);
+		char *str = consumestr(&extra, &extra_size);
+
+		if (!str) {
+			ret = -EINVAL;
+			goto out;
+		}
+		if (!*str)
+			continue;
+		*field = strdup(str);
+		if (!*field) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+	ret = 0;
+
+out:
+	munmap(base, st.st_size);
+	return ret;
+}
+
+/*
+ * Saved state of a running jail: [header][counter fds][cgroup leaf]. It
+ * describes the jail's processes and the fds that follow them, not how it was
+ * launched, so only a jail that has been run can be saved.
+ */
+#define STATE_MAGIC 0x534a494d /* "MIJS" */
+#define STATE_VERSION 1
+
+struct state_header {
+	uint32_t magic;
+	uint32_t version;
+	int32_t initpid;
+	uint32_t pids : 1;
+	uint32_t forward_signals : 1;
+	uint64_t start_time;
+	int32_t notify_fd;
+	uint32_t counter_fd_count;
+	uint32_t cgroup_leaf_size;
+	char notify_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+	struct minijail_counters counters_prev;
+};
+
+/*
+ * Copies minijail_save_state() has handed over to the supervisor's execve(2).
+ * They aren't close-on-exec, so the children of later launches close them.
+ */
+static int *saved_state_fds;
+static size_t saved_state_fd_count;
+
+/*
+ * Stores in @copy a duplicate of @fd, if open, that survives the supervisor's
+ * execve(2). @fd itself stays close-on-exec.
+ */
+static int keep_across_exec(int fd, int32_t *copy)
+{
+	int *fds;
+
+	*copy = -1;
+	if (fd < 0)
+		return 0;
+	fds = realloc(saved_state_fds,
+		      (saved_state_fd_count + 1) * sizeof(*saved_state_fds));
+	if (!fds)
+		return -ENOMEM;
+	saved_state_fds = fds;
+	*copy = fcntl(fd, F_DUPFD, 0);
+	if (*copy < 0)
+		return -errno;
+	saved_state_fds[saved_state_fd_count++] = *copy;
+	return 0;
+}
+
+/* Closes the copies kept since @from, e.g. when saving fails halfway. */
+static void drop_saved_state_fds(size_t from)
+{
+	while (saved_state_fd_count > from)
+		close(saved_state_fds[--saved_state_fd_count]);
+}
+
+/* Stops tracking @fd once a jail adopted in this process owns it. */
+static void forget_saved_state_fd(int fd)
+{
+	size_t i;
+
+	for (i = 0; i < saved_state_fd_count; i++) {
+		if (saved_state_fds[i] == fd) {
+			saved_state_fds[i] =
+			    saved_state_fds[--saved_state_fd_count];
+			return;
+		}
+	}
+}
+
+int API minijail_save_state(const struct minijail *j, int fd)
+{
+	struct state_header hdr = {
+		.magic = STATE_MAGIC,
+		.version = STATE_VERSION,
+		.notify_fd = -1,
+	};
+	size_t saved_from = saved_state_fd_count;
+	size_t fds_size, total;
+	char *buf;
+	size_t i;
+	ssize_t written;
+	int ret;
+
+	if (j->initpid <= 0)
+		return -EINVAL;
+	ret = read_proc_start_time(j->initpid, &hdr.start_time);
+	if (ret)
+		return ret;
+
+	hdr.initpid = j->initpid;
+	hdr.pids = j->flags.pids;
+	hdr.forward_signals = j->flags.forward_signals;
+	hdr.counter_fd_count = j->counter_fd_count;
+	hdr.counters_prev = j->counters_prev;
+	hdr.cgroup_leaf_size = j->cgroup_leaf ? strlen(j->cgroup_leaf) + 1 : 0;
+
+	fds_size = j->counter_fd_count * sizeof(int32_t);
+	total = sizeof(hdr) + fds_size + hdr.cgroup_leaf_size;
+	buf = malloc(total);
 	if (!buf)
 		return -ENOMEM;
-	bytes = read(fd, buf, sz);
-	if (bytes != sz) {
-		free(buf);
-		return -EINVAL;
+	if (j->flags.notify_ready) {
+		ret = keep_across_exec(j->notify_fd, &hdr.notify_fd);
+		if (ret)
+			goto out;
+		memcpy(hdr.notify_path, j->notify_path, sizeof(hdr.notify_path));
 	}
-	r = minijail_unmarshal(j, buf, sz);
+	memcpy(buf, &hdr, sizeof(hdr));
+	for (i = 0; i < j->counter_fd_count; i++) {
+		int32_t counter_fd;
+		ret = keep_across_exec(j->counter_fds[i], &counter_fd);
+		if (ret)
+			goto out;
+		memcpy(buf + sizeof(hdr) + i * sizeof(int32_t), &counter_fd,
+		       sizeof(counter_fd));
+	}
+	if (j->cgroup_leaf)
+		memcpy(buf + sizeof(hdr) + fds_size, j->cgroup_leaf,
+		       hdr.cgroup_leaf_size);
+
+	written = write(fd, buf, total);
+	if (written < 0)
+		ret = -errno;
+	else if ((size_t)written != total)
+		ret = -EIO;
+out:
 	free(buf);
-	return r;
+	if (ret)
+		drop_saved_state_fds(saved_from);
+	return ret;
 }
 
-int API minijail_to_fd(struct minijail *j, int fd)
+/*
+ * adopted_process_alive: Checks that @pid is still the process that started
+ * at @start_time, not a new one that reused its pid.
+ */
+static int adopted_process_alive(pid_t pid, uint64_t start_time)
 {
-	char *buf;
-	size_t sz = minijail_size(j);
-	ssize_t written;
-	int r;
+	uint64_t now_start_time;
+	int pidfd, ret;
+
+	/* A pidfd pins the process while we look at it, if we can get one. */
+	pidfd = sys_pidfd_open(pid, 0);
+	if (pidfd < 0 && errno != ENOSYS)
+		return -ESRCH;
+	ret = read_proc_start_time(pid, &now_start_time);
+	if (pidfd >= 0)
+		close(pidfd);
+	if (ret)
+		return -ESRCH;
+	return now_start_time == start_time ? 0 : -ESRCH;
+}
 
-	if (!sz)
-		return -EINVAL;
-	buf = malloc(sz);
-	r = minijail_marshal(j, buf, sz);
-	if (r) {
-		free(buf);
-		return r;
+struct minijail API *minijail_adopt(int fd)
+{
+	struct state_header hdr;
+	struct minijail *j;
+	size_t fds_size;
+	size_t i;
+	ssize_t len;
+	int ret;
+
+	len = pread(fd, &hdr, sizeof(hdr), 0);
+	if (len != (ssize_t)sizeof(hdr) || hdr.magic != STATE_MAGIC ||
+	    hdr.version != STATE_VERSION || hdr.initpid <= 0 ||
+	    hdr.counter_fd_count > MINIJAIL_COUNTER_COUNT * CPU_SETSIZE ||
+	    hdr.cgroup_leaf_size > PATH_MAX ||
+	    hdr.notify_path[sizeof(hdr.notify_path) - 1] != '\0') {
+		errno = EINVAL;
+		return NULL;
 	}
-	/* Sends [size][minijail]. */
-	written = write(fd, &sz, sizeof(sz));
-	if (written != sizeof(sz)) {
-		free(buf);
-		return -EFAULT;
+	ret = adopted_process_alive(hdr.initpid, hdr.start_time);
+	if (ret) {
+		errno = -ret;
+		return NULL;
 	}
-	written = write(fd, buf, sz);
-	if (written < 0 || (size_t) written != sz) {
-		free(buf);
-		return -EFAULT;
+
+	j = minijail_new();
+	if (!j)
+		return NULL;
+	j->initpid = hdr.initpid;
+	j->flags.pids = hdr.pids;
+	fds_size = hdr.counter_fd_count * sizeof(int32_t);
+
+	if (hdr.counter_fd_count) {
+		j->counter_fds = calloc(hdr.counter_fd_count, sizeof(int));
+		if (!j->counter_fds)
+			goto error;
+		for (i = 0; i < hdr.counter_fd_count; i++) {
+			int32_t counter_fd;
+			if (pread(fd, &counter_fd, sizeof(counter_fd),
+				  sizeof(hdr) + i * sizeof(counter_fd)) !=
+			    (ssize_t)sizeof(counter_fd))
+				goto error_einval;
+			j->counter_fds[i] = counter_fd;
+		}
+		j->counter_fd_count = hdr.counter_fd_count;
+		j->counters_prev = hdr.counters_prev;
+		j->flags.counters = 1;
 	}
-	free(buf);
-	return 0;
+	if (hdr.cgroup_leaf_size) {
+		j->cgroup_leaf = malloc(hdr.cgroup_leaf_size);
+		if (!j->cgroup_leaf)
+			goto error;
+		if (pread(fd, j->cgroup_leaf, hdr.cgroup_leaf_size,
+			  sizeof(hdr) + fds_size) !=
+			(ssize_t)hdr.cgroup_leaf_size ||
+		    j->cgroup_leaf[hdr.cgroup_leaf_size - 1] != '\0')
+			goto error_einval;
+	}
+	if (hdr.notify_fd >= 0) {
+		j->notify_fd = hdr.notify_fd;
+		memcpy(j->notify_path, hdr.notify_path, sizeof(j->notify_path));
+		j->flags.notify_ready = 1;
+		/* The copy only had to survive the supervisor's execve(2). */
+		fcntl(j->notify_fd, F_SETFD, FD_CLOEXEC);
+		forget_saved_state_fd(j->notify_fd);
+	}
+	for (i = 0; i < j->counter_fd_count; i++) {
+		if (j->counter_fds[i] >= 0) {
+			fcntl(j->counter_fds[i], F_SETFD, FD_CLOEXEC);
+			forget_saved_state_fd(j->counter_fds[i]);
+		}
+	}
+	if (hdr.forward_signals) {
+		j->flags.forward_signals = 1;
+		forward_pid = j->initpid;
+		install_signal_handlers();
+	}
+	return j;
+
+error_einval:
+	errno = EINVAL;
+error:
+	ret = errno;
+	/* The fds still belong to the caller. */
+	free(j->counter_fds);
+	free(j->cgroup_leaf);
+	free(j);
+	errno = ret;
+	return NULL;
 }
 
 int setup_preload(void)
@@ -1889,7 +3757,8 @@ int setup_preload(void)
 
 static int setup_pipe(int fds[2])
 {
-	int r = pipe(fds);
+	/* The child sets up its stdio before it is done with this pipe. */
+	int r = pipe_above_stdio(fds);
 	char fd_buf[11];
 	if (r)
 		return r;
@@ -1995,6 +3864,7 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 			  int use_preload)
 {
 	char *oldenv, *oldenv_copy = NULL;
+	char *oldnotify = NULL;
 	pid_t child_pid;
 	int pipe_fds[2];
 	int stdin_fds[2];
@@ -2007,6 +3877,28 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 	int pid_namespace = j->flags.pids;
 	int do_init = j->flags.do_init;
 
+	/* Hooks don't survive the execve(2) that loads the preload library. */
+	if (use_preload && j->hooks_head)
+		return -EINVAL;
+	/* Only the preload library can set the dumpable flag after execve(2). */
+	if (!use_preload && j->flags.dumpable)
+		return -EINVAL;
+
+	/*
+	 * Point sd_notify(3) in the jail at our socket. As with LD_PRELOAD, set
+	 * the variable around the fork rather than in the child, which may not
+	 * be allowed to take libc locks.
+	 */
+	if (j->flags.notify_ready) {
+		oldnotify = getenv(NOTIFY_SOCKET_ENV);
+		if (oldnotify) {
+			oldnotify = strdup(oldnotify);
+			if (!oldnotify)
+				return -ENOMEM;
+		}
+		setenv(NOTIFY_SOCKET_ENV, j->notify_path, 1);
+	}
+
 	if (use_preload) {
 		oldenv = getenv(kLdPreloadEnvVar);
 		if (oldenv) {
@@ -2082,17 +3974,22 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 
 	/*
 	 * If we want to set up a new uid/gid map in the user namespace,
-	 * or if we need to add the child process to cgroups, create the pipe(2)
-	 * to sync between parent and child.
+	 * or if we need to add the child process to cgroups, set its rlimits,
+	 * adjust its OOM score, start counting or profiling it or plumb its
+	 * network namespace, create the pipe(2) to sync between parent and
+	 * child.
 	 */
-	if (j->flags.userns || j->flags.cgroups) {
+	if (j->flags.userns || j->flags.cgroups || j->flags.cgroup_v2 ||
+	    j->rlimit_count || j->flags.oom_score_adj || j->flags.counters ||
+	    j->flags.syscall_profile || j->flags.veth) {
 		sync_child = 1;
-		if (pipe(child_sync_pipe_fds))
+		if (pipe_above_stdio(child_sync_pipe_fds))
 			return -EFAULT;
 	}
 
 	/*
-	 * Use sys_clone() if and only if we're creating a pid namespace.
+	 * Use clone_namespaces() if and only if we're creating a pid namespace,
+	 * or a network namespace for minijail_veth().
 	 *
 	 * tl;dr: WARNING: do not mix pid namespaces and multithreading.
 	 *
@@ -2108,10 +4005,11 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 	 * after, but a bunch of seemingly-innocent libc functions like setenv()
 	 * take locks.
 	 *
-	 * Hence, only call sys_clone() if we need to, in order to get at pid
-	 * namespacing. If we follow this path, the child's address space might
-	 * have broken locks; you may only call functions that do not acquire
-	 * any locks.
+	 * Hence, only call clone_namespaces() if we need to, in order to get at
+	 * pid namespacing, or at a network namespace that the parent can set up
+	 * before the child runs (see minijail_veth()). If we follow this path,
+	 * the child's address space might have broken locks; you may only call
+	 * functions that do not acquire any locks.
 	 *
 	 * Unfortunately, fork() acquires every lock it can get its hands on, as
 	 * previously detailed, so this function is highly likely to deadlock
@@ -2132,12 +4030,12 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 	 * problem is fixable or not. It would be nice if we worked in this
 	 * case.
 	 */
-	if (pid_namespace) {
-		int clone_flags = CLONE_NEWPID | SIGCHLD;
-		if (j->flags.userns)
-			clone_flags |= CLONE_NEWUSER;
-		child_pid = syscall(SYS_clone, clone_flags, NULL);
+	if (pid_namespace || j->flags.veth) {
+		/* Create the other namespaces too, rather than unshare(2) them. */
+		j->clone_ns = clone_namespace_flags(j);
+		child_pid = clone_namespaces(j->clone_ns);
 	} else {
+		j->clone_ns = 0;
 		child_pid = fork();
 	}
 
@@ -2159,6 +4057,15 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 			}
 			unsetenv(kFdEnvVar);
 		}
+		if (j->flags.notify_ready) {
+			/* Restore parent's NOTIFY_SOCKET. */
+			if (oldnotify) {
+				setenv(NOTIFY_SOCKET_ENV, oldnotify, 1);
+				free(oldnotify);
+			} else {
+				unsetenv(NOTIFY_SOCKET_ENV);
+			}
+		}
 
 		j->initpid = child_pid;
 
@@ -2173,12 +4080,27 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 		if (j->flags.cgroups)
 			add_to_cgroups_or_die(j);
 
+		if (j->flags.cgroup_v2)
+			create_cgroup_v2_leaf_or_die(j);
+
+		if (j->flags.counters)
+			open_counters(j);
+
+		if (j->flags.syscall_profile)
+			start_syscall_profile(j);
+
 		if (j->rlimit_count)
 			set_rlimits_or_die(j);
 
+		if (j->flags.oom_score_adj)
+			write_oom_score_adj_or_die(j);
+
 		if (j->flags.userns)
 			write_ugid_maps_or_die(j);
 
+		if (j->flags.veth)
+			setup_veth_or_die(j);
+
 		if (sync_child)
 			parent_setup_complete(child_sync_pipe_fds);
 
@@ -2224,6 +4146,7 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 	}
 	/* Child process. */
 	free(oldenv_copy);
+	free(oldnotify);
 
 	if (j->flags.reset_signal_mask) {
 		sigset_t signal_mask;
@@ -2233,8 +4156,12 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 			pdie("sigprocmask failed");
 	}
 
+	/* Copies saved for another jail's supervisor aren't this jail's. */
+	drop_saved_state_fds(0);
+
 	if (j->flags.close_open_fds) {
-		const size_t kMaxInheritableFdsSize = 10;
+		const size_t kMaxInheritableFdsSize = 15;
+		const int log_fd = log_backend_fd();
 		int inheritable_fds[kMaxInheritableFdsSize];
 		size_t size = 0;
 		if (use_preload) {
@@ -2257,17 +4184,31 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 			inheritable_fds[size++] = stderr_fds[0];
 			inheritable_fds[size++] = stderr_fds[1];
 		}
+		/* Namespaces are entered after this. */
+		if (j->flags.enter_vfs)
+			inheritable_fds[size++] = j->mountns_fd;
+		if (j->flags.enter_net)
+			inheritable_fds[size++] = j->netns_fd;
+		if (j->flags.enter_ipc)
+			inheritable_fds[size++] = j->ipcns_fd;
+		/* So is the Landlock ruleset. */
+		if (j->flags.landlock)
+			inheritable_fds[size++] = j->landlock_fd;
+		/*
+		 * Messages from here to execve(2) still need somewhere to
+		 * go, but the program doesn't get the log fd unless it's
+		 * one of its stdio fds.
+		 */
+		if (log_fd >= 0) {
+			inheritable_fds[size++] = log_fd;
+			if (log_fd > STDERR_FILENO)
+				fcntl(log_fd, F_SETFD, FD_CLOEXEC);
+		}
 
 		if (close_open_fds(inheritable_fds, size) < 0)
 			die("failed to close open file descriptors");
 	}
 
-	if (sync_child)
-		wait_for_parent_setup(child_sync_pipe_fds);
-
-	if (j->flags.userns)
-		enter_user_namespace(j);
-
 	/*
 	 * If we want to write to the jailed process' standard input,
 	 * set up the read end of the pipe.
@@ -2311,9 +4252,60 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 		}
 	}
 
+	/*
+	 * Everything above runs while the parent is still writing the pid
+	 * file, cgroups, limits and id maps. From here on the child needs them.
+	 */
+	if (sync_child)
+		wait_for_parent_setup(child_sync_pipe_fds);
+
+	/* The network namespace came with clone(2), set up by the parent. */
+	if (j->flags.veth)
+		j->flags.net = 0;
+
+	if (j->flags.userns)
+		enter_user_namespace(j);
+
+	enter_namespaces(j);
+	run_hooks_or_die(j, MINIJAIL_HOOK_EVENT_POST_NAMESPACES);
+
+	/* The tmpfs goes in the mount namespace enter_namespaces() set up. */
+	if (j->flags.mount_tmp && mount_tmp(j))
+		pdie("mount_tmp");
+
 	/* If running an init program, let it decide when/how to mount /proc. */
 	if (pid_namespace && !do_init)
 		j->flags.remount_proc_ro = 0;
+	run_hooks_or_die(j, MINIJAIL_HOOK_EVENT_POST_MOUNTS);
+
+	/*
+	 * Scheduling attributes and memory policies survive execve(2), so both
+	 * launch paths set them here, while we still have the privileges to
+	 * raise them.
+	 */
+	set_scheduling(j);
+	set_memory_policy(j);
+
+	/* Landlock would also tie the hooks' hands, so they go first. */
+	run_hooks_or_die(j, MINIJAIL_HOOK_EVENT_PRE_DROP_CAPS);
+
+	/*
+	 * Landlock goes on after the mounts it would otherwise get in the way
+	 * of, and stays in force across execve(2), so this confines the program
+	 * on both launch paths. Without CAP_SYS_ADMIN, landlock_restrict_self()
+	 * fails with EPERM unless no_new_privs is set, so set it then too.
+	 */
+	if (j->flags.landlock) {
+		if (j->flags.no_new_privs &&
+		    prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0))
+			pdie("prctl(PR_SET_NO_NEW_PRIVS)");
+		if (sys_landlock_restrict_self(j->landlock_fd, 0) &&
+		    (errno != EPERM || prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) ||
+		     sys_landlock_restrict_self(j->landlock_fd, 0)))
+			pdie("landlock_restrict_self() failed");
+		close(j->landlock_fd);
+		j->flags.landlock = 0;
+	}
 
 	if (use_preload) {
 		/* Strip out flags that cannot be inherited across execve(2). */
@@ -2361,6 +4353,7 @@ int minijail_run_internal(struct minijail *j, const char *filename,
 	 *   -> init()-ing process
 	 *      -> execve()-ing process
 	 */
+	run_hooks_or_die(j, MINIJAIL_HOOK_EVENT_PRE_EXECVE);
 	ret = execve(filename, argv, environ);
 	if (ret == -1) {
 		pwarn("execve(%s) failed", filename);
@@ -2375,14 +4368,292 @@ int API minijail_kill(struct minijail *j)
 		return -errno;
 	if (waitpid(j->initpid, &st, 0) < 0)
 		return -errno;
+	remove_cgroup_v2_leaf(j);
+	return st;
+}
+
+int API minijail_kill_tree(struct minijail *j)
+{
+	if (!j->cgroup_leaf) {
+		/* Killing init tears down the whole pid namespace. */
+		if (!j->flags.pids)
+			return -EINVAL;
+		if (kill(j->initpid, SIGKILL))
+			return -errno;
+		return 0;
+	}
+	return write_cgroup_file(j->cgroup_leaf, "cgroup.kill", "1");
+}
+
+int API minijail_freeze(struct minijail *j)
+{
+	if (!j->cgroup_leaf)
+		return -EINVAL;
+	return write_cgroup_file(j->cgroup_leaf, "cgroup.freeze", "1");
+}
+
+int API minijail_thaw(struct minijail *j)
+{
+	if (!j->cgroup_leaf)
+		return -EINVAL;
+	return write_cgroup_file(j->cgroup_leaf, "cgroup.freeze", "0");
+}
+
+int API minijail_reset_tmp(struct minijail *j)
+{
+	char path[32];
+	struct stat jail_ns, self_ns;
+	int root_fd, mnt_fd, user_fd = -1;
+	int ret = 0;
+	pid_t pid;
+	int st;
+
+	if (!j->flags.mount_tmp)
+		return -EINVAL;
+	if (j->initpid <= 0)
+		return -ESRCH;
+
+	snprintf(path, sizeof(path), "/proc/%d/root", j->initpid);
+	root_fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (root_fd < 0)
+		return -errno;
+	snprintf(path, sizeof(path), "/proc/%d/ns/mnt", j->initpid);
+	mnt_fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (mnt_fd < 0) {
+		ret = -errno;
+		goto out;
+	}
+	/* Never swap out our own /tmp. */
+	if (fstat(mnt_fd, &jail_ns) || stat("/proc/self/ns/mnt", &self_ns)) {
+		ret = -errno;
+		goto out;
+	}
+	if (jail_ns.st_ino == self_ns.st_ino &&
+	    jail_ns.st_dev == self_ns.st_dev) {
+		ret = -EINVAL;
+		goto out;
+	}
+	if (j->flags.userns) {
+		snprintf(path, sizeof(path), "/proc/%d/ns/user", j->initpid);
+		user_fd = open(path, O_RDONLY | O_CLOEXEC);
+		if (user_fd < 0) {
+			ret = -errno;
+			goto out;
+		}
+	}
+
+	/*
+	 * setns(2) into a mount namespace needs a single-threaded caller.
+	 * Putting a fresh tmpfs over the old one beats deleting whatever the
+	 * last job left behind; files still open in the old one stay valid.
+	 */
+	pid = fork();
+	if (pid < 0) {
+		ret = -errno;
+		goto out;
+	}
+	if (pid == 0) {
+		if (user_fd >= 0 && setns(user_fd, CLONE_NEWUSER))
+			_exit(errno);
+		if (setns(mnt_fd, CLONE_NEWNS))
+			_exit(errno);
+		if (fchdir(root_fd) || chroot("."))
+			_exit(errno);
+		if (umount2("/tmp", MNT_DETACH) || mount_tmp(j))
+			_exit(errno);
+		_exit(0);
+	}
+	if (waitpid(pid, &st, 0) < 0)
+		ret = -errno;
+	else if (!WIFEXITED(st))
+		ret = -ECHILD;
+	else
+		ret = -WEXITSTATUS(st);
+
+out:
+	if (user_fd >= 0)
+		close(user_fd);
+	if (mnt_fd >= 0)
+		close(mnt_fd);
+	close(root_fd);
+	return ret;
+}
+
+int API minijail_wait_counters(struct minijail *j,
+			       struct minijail_counters *counters)
+{
+	int st = minijail_wait(j);
+
+	/* Counters keep their final values once everything they follow exits. */
+	if (minijail_read_counters(j, counters, NULL))
+		memset(counters, 0, sizeof(*counters));
 	return st;
 }
 
+/* Milliseconds left until @deadline, or 0 if it has passed. */
+static int ms_until(const struct timespec *deadline)
+{
+	struct timespec now;
+	int64_t ms;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	ms = (deadline->tv_sec - now.tv_sec) * 1000 +
+	     (deadline->tv_nsec - now.tv_nsec) / 1000000;
+	return ms > 0 ? (ms > INT_MAX ? INT_MAX : ms) : 0;
+}
+
+/* Returns 1 if processes @a and @b share a pid namespace. */
+static int same_pid_namespace(pid_t a, pid_t b)
+{
+	char path[64];
+	struct stat st_a, st_b;
+
+	snprintf(path, sizeof(path), "/proc/%d/ns/pid", a);
+	if (stat(path, &st_a))
+		return 0;
+	snprintf(path, sizeof(path), "/proc/%d/ns/pid", b);
+	if (stat(path, &st_b))
+		return 0;
+	return st_a.st_dev == st_b.st_dev && st_a.st_ino == st_b.st_ino;
+}
+
+/* Returns 1 if @pid is listed in the cgroup.procs of @cgroup_dir. */
+static int pid_in_cgroup(const char *cgroup_dir, pid_t pid)
+{
+	char path[PATH_MAX];
+	FILE *procs;
+	int member;
+	int found = 0;
+	int ret;
+
+	ret = snprintf(path, sizeof(path), "%s/cgroup.procs", cgroup_dir);
+	if (ret < 0 || (size_t)ret >= sizeof(path))
+		return 0;
+	procs = fopen(path, "re");
+	if (!procs)
+		return 0;
+	while (!found && fscanf(procs, "%d", &member) == 1)
+		found = member == pid;
+	fclose(procs);
+	return found;
+}
+
+/*
+ * recv_jail_notification: Receives a message from the notify socket of @j into
+ * @buf, as long as it comes from the jail: its init, anything else in its pid
+ * namespace, or anything in its cgroup. Like systemd, this drops messages from
+ * anyone else who can reach the socket.
+ *
+ * Returns the message length, or 0 if there wasn't one from the jail.
+ */
+static ssize_t recv_jail_notification(const struct minijail *j, char *buf,
+				      size_t len)
+{
+	union {
+		struct cmsghdr hdr;
+		char buf[CMSG_SPACE(sizeof(struct ucred))];
+	} control;
+	struct iovec iov = {.iov_base = buf, .iov_len = len};
+	struct msghdr mh = {
+	    .msg_iov = &iov,
+	    .msg_iovlen = 1,
+	    .msg_control = &control,
+	    .msg_controllen = sizeof(control),
+	};
+	const struct ucred *cred = NULL;
+	struct cmsghdr *cmsg;
+	ssize_t ret;
+
+	ret = recvmsg(j->notify_fd, &mh, MSG_DONTWAIT);
+	if (ret <= 0)
+		return 0;
+	for (cmsg = CMSG_FIRSTHDR(&mh); cmsg; cmsg = CMSG_NXTHDR(&mh, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET &&
+		    cmsg->cmsg_type == SCM_CREDENTIALS)
+			cred = (const struct ucred *)CMSG_DATA(cmsg);
+	}
+	if (!cred)
+		return 0;
+	if (cred->pid == j->initpid ||
+	    (j->flags.pids && same_pid_namespace(cred->pid, j->initpid)) ||
+	    (j->cgroup_leaf && pid_in_cgroup(j->cgroup_leaf, cred->pid)))
+		return ret;
+	warn("ignoring notification from pid %d outside the jail", cred->pid);
+	return 0;
+}
+
+int API minijail_wait_ready(struct minijail *j, int timeout_ms)
+{
+	struct pollfd fds[2];
+	struct timespec deadline;
+	char msg[4096];
+	nfds_t nfds = 1;
+	int pidfd, ret;
+
+	if (!j->flags.notify_ready || j->initpid <= 0)
+		return -EINVAL;
+
+	fds[0].fd = j->notify_fd;
+	fds[0].events = POLLIN;
+	/*
+	 * Watch the jail's init through a pidfd so that a service that dies
+	 * before it's ready doesn't make us wait out the whole timeout. Older
+	 * kernels without pidfds still get the timeout.
+	 */
+	pidfd = sys_pidfd_open(j->initpid, 0);
+	if (pidfd >= 0) {
+		fds[1].fd = pidfd;
+		fds[1].events = POLLIN;
+		nfds = 2;
+	}
+	if (timeout_ms >= 0) {
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_sec += timeout_ms / 1000;
+		deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+	}
+
+	for (;;) {
+		ret = poll(fds, nfds, timeout_ms < 0 ? -1 : ms_until(&deadline));
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			ret = -errno;
+			break;
+		}
+		if (ret == 0) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+		/* Read messages first: a service may say READY=1 and exit. */
+		if (fds[0].revents & POLLIN) {
+			ssize_t len =
+			    recv_jail_notification(j, msg, sizeof(msg));
+			if (len > 0 && is_ready_notification(msg, len)) {
+				ret = 0;
+				break;
+			}
+			continue;
+		}
+		if (nfds == 2 && fds[1].revents) {
+			ret = -ECHILD;
+			break;
+		}
+	}
+	if (pidfd >= 0)
+		close(pidfd);
+	return ret;
+}
+
 int API minijail_wait(struct minijail *j)
 {
 	int st;
 	if (waitpid(j->initpid, &st, 0) < 0)
 		return -errno;
+	remove_cgroup_v2_leaf(j);
 
 	if (!WIFEXITED(st)) {
 		int error_status = st;
@@ -2414,7 +4685,11 @@ int API minijail_wait(struct minijail *j)
 	return exit_status;
 }
 
-void API minijail_destroy(struct minijail *j)
+/*
+ * free_launch_config: Frees everything in @j that is only needed to launch the
+ * jail, and not to wait for, signal or account for it afterwards.
+ */
+static void free_launch_config(struct minijail *j)
 {
 	size_t i;
 
@@ -2422,33 +4697,88 @@ void API minijail_destroy(struct minijail *j)
 		free(j->filter_prog->filter);
 		free(j->filter_prog);
 	}
+	j->filter_prog = NULL;
+	j->filter_len = 0;
 	while (j->mounts_head) {
 		struct mountpoint *m = j->mounts_head;
 		j->mounts_head = j->mounts_head->next;
-		free(m->data);
-		free(m->type);
-		free(m->dest);
-		free(m->src);
-		free(m);
+		free_mountpoint(m);
 	}
 	j->mounts_tail = NULL;
-	if (j->user)
-		free(j->user);
-	if (j->suppl_gid_list)
-		free(j->suppl_gid_list);
-	if (j->chrootdir)
-		free(j->chrootdir);
-	if (j->pid_file_path)
-		free(j->pid_file_path);
-	if (j->uidmap)
-		free(j->uidmap);
-	if (j->gidmap)
-		free(j->gidmap);
-	if (j->hostname)
-		free(j->hostname);
-	if (j->alt_syscall_table)
-		free(j->alt_syscall_table);
+	j->mounts_count = 0;
+	free(j->user);
+	j->user = NULL;
+	free(j->suppl_gid_list);
+	j->suppl_gid_list = NULL;
+	j->suppl_gid_count = 0;
+	free(j->chrootdir);
+	j->chrootdir = NULL;
+	free(j->pid_file_path);
+	j->pid_file_path = NULL;
+	free(j->uidmap);
+	j->uidmap = NULL;
+	free(j->gidmap);
+	j->gidmap = NULL;
+	free(j->hostname);
+	j->hostname = NULL;
+	free(j->alt_syscall_table);
+	j->alt_syscall_table = NULL;
 	for (i = 0; i < j->cgroup_count; ++i)
 		free(j->cgroups[i]);
+	j->cgroup_count = 0;
+	free(j->cgroup_parent);
+	j->cgroup_parent = NULL;
+	free(j->cgroup_io_max);
+	j->cgroup_io_max = NULL;
+	if (j->flags.landlock)
+		close(j->landlock_fd);
+	j->flags.landlock = 0;
+	while (j->hooks_head) {
+		struct hook *h = j->hooks_head;
+		j->hooks_head = h->next;
+		free(h);
+	}
+	j->hooks_tail = NULL;
+}
+
+void API minijail_trim(struct minijail *j)
+{
+	free_launch_config(j);
+#if defined(__GLIBC__)
+	/* Hand the now free heap pages back to the kernel. */
+	malloc_trim(0);
+#endif
+}
+
+int API minijail_set_logging(enum minijail_log_backend backend, int fd)
+{
+	switch (backend) {
+	case MINIJAIL_LOG_TO_SYSLOG:
+		return set_log_backend(LOG_TO_SYSLOG, -1);
+	case MINIJAIL_LOG_TO_FD:
+		return set_log_backend(LOG_TO_FD, fd);
+	case MINIJAIL_LOG_TO_RING:
+		return set_log_backend(LOG_TO_RING, -1);
+	}
+	return -EINVAL;
+}
+
+ssize_t API minijail_drain_log(char *buf, size_t size)
+{
+	return drain_log_ring(buf, size);
+}
+
+void API minijail_destroy(struct minijail *j)
+{
+	free_launch_config(j);
+	if (j->cgroup_leaf)
+		free(j->cgroup_leaf);
+	close_counters(j);
+	syscall_profile_free(j->syscall_profile);
+	if (j->flags.notify_ready) {
+		close(j->notify_fd);
+		if (j->notify_path[0] != '@')
+			unlink(j->notify_path);
+	}
 	free(j);
 }
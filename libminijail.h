@@ -77,7 +77,78 @@ void minijail_namespace_uts(struct minijail *j);
 int minijail_namespace_set_hostname(struct minijail *j, const char *name);
 void minijail_namespace_net(struct minijail *j);
 void minijail_namespace_enter_net(struct minijail *j, const char *ns_path);
+/*
+ * minijail_veth: runs the jail in a new network namespace (see
+ * minijail_namespace_net()) connected to the caller's by a veth pair. The
+ * end named @host_ifname stays in the caller's namespace, @jail_ifname goes
+ * into the jail's. Both ends and the jail's loopback are brought up over
+ * rtnetlink before the jailed program runs. Needs CAP_NET_ADMIN and
+ * CAP_SYS_ADMIN. Cannot be combined with minijail_namespace_enter_net().
+ *
+ * Returns 0 on success, -EINVAL for invalid interface names.
+ */
+int minijail_veth(struct minijail *j, const char *host_ifname,
+		  const char *jail_ifname);
+/*
+ * minijail_veth_addrs: assigns IPv4 addresses with a prefix length, like
+ * "10.0.0.1/24", to both ends of the pair from minijail_veth(). The jail's
+ * default route goes through @host_addr.
+ *
+ * Returns 0 on success, -EINVAL for malformed addresses or prefix lengths
+ * that differ.
+ */
+int minijail_veth_addrs(struct minijail *j, const char *host_addr,
+			const char *jail_addr);
 void minijail_namespace_cgroups(struct minijail *j);
+
+#define MINIJAIL_FS_READ (1 << 0)
+#define MINIJAIL_FS_WRITE (1 << 1)
+#define MINIJAIL_FS_EXEC (1 << 2)
+
+/*
+ * minijail_restrict_fs: confines the jail's filesystem access with Landlock,
+ * without a mount namespace. The first call denies everything; each call
+ * allows @access, a mask of MINIJAIL_FS_*, beneath @path. Read covers listing
+ * directories; write covers creating, changing and removing files. Paths are
+ * resolved now, in the caller's view of the filesystem. The program itself,
+ * and its libraries, need MINIJAIL_FS_EXEC (and read, to be loaded).
+ * Unless the jail keeps CAP_SYS_ADMIN, Landlock needs no_new_privs, so the
+ * jail gets it as if minijail_no_new_privs() had been called.
+ * On kernels without Landlock this only warns, and nothing is restricted.
+ *
+ * Returns 0 on success, -EINVAL for bad @access, or -errno if @path can't be
+ * opened.
+ */
+int minijail_restrict_fs(struct minijail *j, const char *path, int access);
+
+/*
+ * Namespace groups let cooperating jails share network and IPC namespaces,
+ * e.g. to talk over loopback or POSIX shared memory, while each keeps its own
+ * mount, pid and user namespaces and restrictions.
+ */
+#define MINIJAIL_GROUP_NET (1 << 0)
+#define MINIJAIL_GROUP_IPC (1 << 1)
+
+struct minijail_group;
+
+/*
+ * minijail_group_new: creates the namespaces in @namespaces, a mask of
+ * MINIJAIL_GROUP_* flags, once for the whole group. The caller stays in its
+ * own namespaces. A new network namespace has its loopback up.
+ *
+ * Returns NULL with errno set on failure.
+ */
+struct minijail_group *minijail_group_new(int namespaces);
+/*
+ * minijail_group_add: makes @j enter the group's namespaces with setns(2)
+ * when it is run, instead of creating or entering its own. The group must
+ * not be destroyed before its members have been run.
+ *
+ * Returns 0 on success, -EINVAL if @j already enters another namespace of a
+ * type the group shares.
+ */
+int minijail_group_add(struct minijail_group *group, struct minijail *j);
+void minijail_group_destroy(struct minijail_group *group);
 /* Closes all open file descriptors after forking. */
 void minijail_close_open_fds(struct minijail *j);
 /*
@@ -102,6 +173,139 @@ int minijail_use_alt_syscall(struct minijail *j, const char *table);
 /* Sets the given runtime limit. See getrlimit(2). */
 int minijail_rlimit(struct minijail *j, int type, uint32_t cur, uint32_t max);
 
+/*
+ * CPU placement and scheduling attributes, applied before privileges are
+ * dropped. See sched_setaffinity(2), sched_setattr(2), setpriority(2),
+ * ioprio_set(2) and PR_SET_TIMERSLACK in prctl(2).
+ */
+/* Restricts the jail to the CPUs in |cpus|, a list like "0-3,8". */
+int minijail_set_cpu_affinity(struct minijail *j, const char *cpus);
+/* |policy| is one of SCHED_OTHER, SCHED_BATCH or SCHED_IDLE. */
+int minijail_set_sched_policy(struct minijail *j, int policy);
+/* Sets utilization clamps, 0 <= |min| <= |max| <= 1024. */
+int minijail_set_uclamp(struct minijail *j, uint32_t min, uint32_t max);
+int minijail_set_nice(struct minijail *j, int nice);
+enum {
+	MINIJAIL_IOPRIO_CLASS_RT = 1,
+	MINIJAIL_IOPRIO_CLASS_BE = 2,
+	MINIJAIL_IOPRIO_CLASS_IDLE = 3,
+};
+/* |level| is 0 (highest) to 7 (lowest) within |ioclass|. */
+int minijail_set_ioprio(struct minijail *j, int ioclass, int level);
+int minijail_set_timerslack(struct minijail *j, unsigned long slack_ns);
+
+/*
+ * Memory placement, applied by minijail_enter(). See set_mempolicy(2).
+ * |nodes| is a list of NUMA nodes like "0-1". With a cgroup from
+ * minijail_cgroup_v2_parent(), a MINIJAIL_MPOL_BIND policy is mirrored in the
+ * cgroup's cpuset.mems, as is minijail_set_cpu_affinity() in cpuset.cpus.
+ */
+enum {
+	MINIJAIL_MPOL_PREFERRED = 1,
+	MINIJAIL_MPOL_BIND = 2,
+	MINIJAIL_MPOL_INTERLEAVE = 3,
+};
+int minijail_set_mempolicy(struct minijail *j, int mode, const char *nodes);
+/*
+ * Disables transparent huge pages for the jail if |enabled| is 0, or lifts an
+ * inherited PR_SET_THP_DISABLE otherwise. See prctl(2).
+ */
+void minijail_set_thp(struct minijail *j, int enabled);
+/*
+ * Opts the jail into kernel samepage merging for all of its anonymous memory,
+ * with prctl(PR_SET_MEMORY_MERGE). Requires Linux 6.4 or later.
+ */
+void minijail_enable_ksm(struct minijail *j);
+
+/* Page counts from /proc/<pid>/ksm_stat, see proc(5). */
+struct minijail_ksm_stat {
+	uint64_t merging_pages;
+	uint64_t rmap_items;
+	int64_t process_profit;
+};
+
+/*
+ * minijail_ksm_stat: reports KSM statistics for a running jail into @stat,
+ * summed over every process in the jail's cgroup if it has one (see
+ * minijail_cgroup_v2_parent()), or for the jailed process otherwise.
+ *
+ * Returns 0 on success.
+ */
+int minijail_ksm_stat(struct minijail *j, struct minijail_ksm_stat *stat);
+
+enum minijail_counter {
+	MINIJAIL_COUNTER_CYCLES,
+	MINIJAIL_COUNTER_INSTRUCTIONS,
+	MINIJAIL_COUNTER_CACHE_MISSES,
+	MINIJAIL_COUNTER_CONTEXT_SWITCHES,
+	MINIJAIL_COUNTER_PAGE_FAULTS,
+	MINIJAIL_COUNTER_COUNT,
+};
+
+struct minijail_counters {
+	uint64_t value[MINIJAIL_COUNTER_COUNT];
+	/* Bit (1 << counter) is set for each counter that could be read. */
+	uint32_t valid;
+};
+
+/*
+ * minijail_use_counters: counts cycles, instructions, cache misses, context
+ * switches and page faults for the jail with perf_event_open(2). With a
+ * cgroup from minijail_cgroup_v2_parent() the counters cover the whole cgroup;
+ * otherwise they follow the jailed process and its descendants. Counting
+ * starts before the jailed program runs. Counters the kernel or hardware
+ * cannot provide are left out of minijail_counters.valid.
+ */
+void minijail_use_counters(struct minijail *j);
+
+/*
+ * minijail_read_counters: reads the jail's counters into @counters. If @delta
+ * is not NULL it receives the change since the previous read (or since the
+ * jail started). Counters stay readable after the jail exits, until
+ * minijail_destroy().
+ *
+ * Returns 0 on success, -EINVAL if the jail is not counting.
+ */
+int minijail_read_counters(struct minijail *j,
+			   struct minijail_counters *counters,
+			   struct minijail_counters *delta);
+
+/*
+ * minijail_profile_syscalls: counts and times every syscall made in the jail's
+ * cgroup (see minijail_cgroup_v2_parent()) with eBPF programs attached to the
+ * raw_syscalls tracepoints. Needs CAP_BPF and CAP_PERFMON (or CAP_SYS_ADMIN);
+ * without them, or without a cgroup, the jail runs unprofiled.
+ */
+void minijail_profile_syscalls(struct minijail *j);
+
+/*
+ * minijail_dump_syscall_profile: writes the profile to @fd as a seccomp policy
+ * of "name: 1" lines, most frequent first, with the call counts in comments.
+ * If @latency is set, each line is followed by a comment line with a log2
+ * histogram of the syscall's latency in ns. The
+ * profile stays readable after the jail exits, until minijail_destroy().
+ *
+ * Returns 0 on success, -EINVAL if the jail is not being profiled.
+ */
+int minijail_dump_syscall_profile(struct minijail *j, int fd, int latency);
+
+/*
+ * Sets whether the jail dumps core, and can be ptraced by its own user, with
+ * prctl(PR_SET_DUMPABLE) once it has changed uids, which otherwise clears it.
+ * execve(2) resets the flag, so only the preload library can set it:
+ * minijail_run_no_preload() and friends fail with -EINVAL, and a core limit
+ * of 0 is the way to turn dumps off there.
+ */
+void minijail_set_dumpable(struct minijail *j, int dumpable);
+/*
+ * Caps the jail's core dumps at @bytes with RLIMIT_CORE; 0 turns them off.
+ * Returns -ERANGE above 4 GiB, or -EEXIST if RLIMIT_CORE is already set.
+ */
+int minijail_set_core_limit(struct minijail *j, uint64_t bytes);
+
+/* Written to /proc/<pid>/oom_score_adj by the parent, in [-1000, 1000]. */
+int minijail_set_oom_score_adj(struct minijail *j, int adj);
+
 /*
  * Adds the jailed process to the cgroup given by |path|.  |path| should be the
  * full path to the cgroups "tasks" file.
@@ -110,6 +314,84 @@ int minijail_rlimit(struct minijail *j, int type, uint32_t cur, uint32_t max);
  */
 int minijail_add_to_cgroup(struct minijail *j, const char *path);
 
+/*
+ * minijail_cgroup_v2_parent: creates a cgroup for the jail under @path
+ * @j    minijail to place in the cgroup
+ * @path cgroup v2 directory to create the per-jail cgroup under, e.g.
+ *       /sys/fs/cgroup/jails
+ *
+ * The per-jail cgroup is created when the jail is run, the limits set with the
+ * minijail_cgroup_v2_*() functions below are applied to it, and it is removed
+ * by minijail_wait() or minijail_kill() once the jail exits. Controllers needed
+ * for those limits are enabled in @path's cgroup.subtree_control.
+ *
+ * Returns 0 on success.
+ */
+int minijail_cgroup_v2_parent(struct minijail *j, const char *path);
+/*
+ * Sets cpu.max to @quota_us of CPU time every @period_us. Both are at least
+ * 1000us, and @period_us is at most 1000000us.
+ */
+int minijail_cgroup_v2_cpu_max(struct minijail *j, uint64_t quota_us,
+			       uint64_t period_us);
+/* Sets cpu.weight, in the range [1, 10000]. */
+int minijail_cgroup_v2_cpu_weight(struct minijail *j, uint64_t weight);
+/* Set memory.high and memory.max, in bytes. */
+int minijail_cgroup_v2_memory_high(struct minijail *j, uint64_t bytes);
+int minijail_cgroup_v2_memory_max(struct minijail *j, uint64_t bytes);
+/*
+ * Adds an io.max line for one device, e.g. "8:0 rbps=1048576 wiops=120".
+ * May be called once per device.
+ */
+int minijail_cgroup_v2_io_max(struct minijail *j, const char *spec);
+/* Sets pids.max. */
+int minijail_cgroup_v2_pids_max(struct minijail *j, uint64_t max);
+
+/* Resources whose pressure stall information (PSI) can be monitored. */
+enum minijail_pressure_resource {
+	MINIJAIL_PRESSURE_CPU,
+	MINIJAIL_PRESSURE_MEMORY,
+	MINIJAIL_PRESSURE_IO,
+};
+
+/* Stall averages are percentages, |total_us| is the cumulative stall time. */
+struct minijail_pressure_avgs {
+	double avg10;
+	double avg60;
+	double avg300;
+	uint64_t total_us;
+};
+
+struct minijail_pressure {
+	struct minijail_pressure_avgs some;
+	struct minijail_pressure_avgs full;
+};
+
+/*
+ * minijail_pressure_trigger: registers a PSI trigger on the jail's cgroup
+ * @j         running minijail with a cgroup from minijail_cgroup_v2_parent()
+ * @resource  one of MINIJAIL_PRESSURE_*
+ * @full      if set, trigger on "full" stalls (all tasks stalled) instead of
+ *            "some" stalls (at least one task stalled)
+ * @stall_us  cumulative stall time within @window_us that fires the trigger
+ * @window_us tracking window, between 500ms and 10s
+ *
+ * Returns a file descriptor that polls with POLLPRI (EPOLLPRI for epoll(7))
+ * every time the trigger fires, or a negative errno. Closing the descriptor
+ * removes the trigger.
+ */
+int minijail_pressure_trigger(struct minijail *j, int resource, int full,
+			      uint64_t stall_us, uint64_t window_us);
+
+/*
+ * minijail_pressure_snapshot: reads the current PSI averages for @resource of
+ * the jail's cgroup into @pressure.
+ *
+ * Returns 0 on success.
+ */
+int minijail_pressure_snapshot(struct minijail *j, int resource,
+			       struct minijail_pressure *pressure);
+
 /*
  * Install signal handlers in the minijail process that forward received
  * signals to the jailed child process.
@@ -129,6 +411,13 @@ int minijail_forward_signals(struct minijail *j);
  */
 int minijail_enter_chroot(struct minijail *j, const char *dir);
 int minijail_enter_pivot_root(struct minijail *j, const char *dir);
+/*
+ * minijail_has_root: returns whether @j enters a chroot or pivot_root, e.g.
+ * after minijail_read_profile().
+ */
+int minijail_has_root(const struct minijail *j);
+/* minijail_has_mount_ns: returns whether @j enters a new mount namespace. */
+int minijail_has_mount_ns(const struct minijail *j);
 
 /*
  * minijail_get_original_path: returns the path of a given file outside of the
@@ -144,17 +433,43 @@ int minijail_enter_pivot_root(struct minijail *j, const char *dir);
 char *minijail_get_original_path(struct minijail *j, const char *chroot_path);
 
 /*
- * minijail_mount_tmp: enables mounting of a 64M tmpfs filesystem on /tmp.
- * As be rules of bind mounts, /tmp must exist in chroot.
+ * minijail_mount_tmp: enables mounting of a 64M tmpfs filesystem on /tmp,
+ * in a new mount namespace. As be rules of bind mounts, /tmp must exist in
+ * chroot.
  */
 void minijail_mount_tmp(struct minijail *j);
 
 /*
- * minijail_mount_tmp_size: enables mounting of a tmpfs filesystem on /tmp.
- * As be rules of bind mounts, /tmp must exist in chroot.  Size is in bytes.
+ * minijail_mount_tmp_size: enables mounting of a tmpfs filesystem on /tmp,
+ * in a new mount namespace. As be rules of bind mounts, /tmp must exist in
+ * chroot.  Size is in bytes.
  */
 void minijail_mount_tmp_size(struct minijail *j, size_t size);
 
+/*
+ * minijail_mount_tmp_opts: like minijail_mount_tmp_size(), with extra tmpfs
+ * options in @opts, a comma-separated list of:
+ *   huge=never|always|within_size|advise  transparent huge page use
+ *   mpol=prefer|bind|interleave:<nodes>   NUMA placement, e.g. bind:0-1
+ *   nr_inodes=<count>                     inode limit, K/M/G suffixes allowed
+ *   noswap                                keep the contents out of swap
+ * The kernel must support what's asked for, or entering the jail fails.
+ *
+ * Returns 0 on success, -EINVAL for an unknown or malformed option.
+ */
+int minijail_mount_tmp_opts(struct minijail *j, size_t size,
+			    const char *opts);
+
+/*
+ * minijail_reset_tmp: replaces the /tmp tmpfs of the running jail @j with an
+ * empty one with the same options, so a pooled jail can be handed its next
+ * job without deleting files one by one.
+ *
+ * Returns 0 on success, -EINVAL if @j has no /tmp tmpfs or shares our mount
+ * namespace, -ESRCH if it isn't running.
+ */
+int minijail_reset_tmp(struct minijail *j);
+
 /*
  * minijail_mount_with_data: when entering minijail @j,
  *   mounts @src at @dst with @flags and @data.
@@ -199,6 +514,68 @@ int minijail_mount(struct minijail *j, const char *src, const char *dest,
 int minijail_bind(struct minijail *j, const char *src, const char *dest,
 		  int writeable);
 
+/*
+ * minijail_optimize_mounts: normalizes the mount plan of @j. Mounts are
+ * reordered so that parents come before their children, exact duplicates and
+ * binds already exposed by an identical recursive parent bind are dropped
+ * unless a mount in between overlaps them, and back-to-back bind remounts of
+ * one destination are folded together. Each removal is logged. The reordering
+ * means a mount that was meant to be covered by a later mount of its parent no
+ * longer is, so this only runs when called before launching @j.
+ * @j minijail whose mounts to rewrite
+ *
+ * Returns the number of mounts removed, or a negative errno.
+ */
+int minijail_optimize_mounts(struct minijail *j);
+
+/*
+ * minijail_notify_socket: binds an sd_notify(3) datagram socket at @path,
+ * with a leading '@' for the abstract namespace, and points NOTIFY_SOCKET at
+ * it in jails launched from @j, so minijail_wait_ready() can tell when the
+ * service is ready. @path must be reachable from inside the jail: bind its
+ * directory in when using a new root, and note that abstract sockets don't
+ * cross network namespaces. A socket left at @path by an earlier run is
+ * replaced, anything else there is not.
+ *
+ * Returns 0 on success, or -EEXIST if @path is taken by something other than a
+ * socket.
+ */
+int minijail_notify_socket(struct minijail *j, const char *path);
+
+/* Points in the jailing sequence where a hook can run. */
+enum minijail_hook_event {
+	/* All namespaces have been entered, nothing has been mounted yet. */
+	MINIJAIL_HOOK_EVENT_POST_NAMESPACES,
+	/* The new root and its mounts are in place. */
+	MINIJAIL_HOOK_EVENT_POST_MOUNTS,
+	/* Still running with the original ids and capabilities. */
+	MINIJAIL_HOOK_EVENT_PRE_DROP_CAPS,
+	/* Fully jailed, right before execve(2). */
+	MINIJAIL_HOOK_EVENT_PRE_EXECVE,
+	MINIJAIL_HOOK_EVENT_MAX,
+};
+
+/* Returns 0 on success, or a negative errno to abort the launch. */
+typedef int (*minijail_hook_t)(void *context);
+
+/*
+ * minijail_add_hook: runs @hook(@context) in the jailed process at @event, so
+ * setup like creating a directory or opening a device doesn't need a wrapper
+ * executable. Hooks for the same event run in the order they were added. A
+ * failing hook kills the jailed process. Hooks only run in the child that
+ * the minijail_run*_no_preload() functions launch, at each point on its way
+ * to execve(2). The LD_PRELOAD launches refuse to start, and minijail_enter()
+ * doesn't run them.
+ * @j       minijail to add the hook to
+ * @hook    function to run
+ * @context argument passed to @hook
+ * @event   when to run @hook
+ *
+ * Returns 0 on success.
+ */
+int minijail_add_hook(struct minijail *j, minijail_hook_t hook, void *context,
+		      enum minijail_hook_event event);
+
 /*
  * Lock this process into the given minijail. Note that this procedure cannot
  * fail, since there is no way to undo privilege-dropping; therefore, if any
@@ -275,12 +652,130 @@ int minijail_run_pid_pipes_no_preload(struct minijail *j, const char *filename,
  */
 int minijail_kill(struct minijail *j);
 
+/*
+ * Kill every process in the specified minijail with SIGKILL without waiting
+ * for them to exit; use minijail_wait() to reap the jail afterwards.
+ * With a cgroup from minijail_cgroup_v2_parent() this uses cgroup.kill, which
+ * also reaches descendants that escaped the jail's process group. Otherwise
+ * the minijail must have been created with pid namespacing.
+ *
+ * Returns 0 on success.
+ */
+int minijail_kill_tree(struct minijail *j);
+
+/*
+ * Freeze or thaw all processes in the specified minijail's cgroup (see
+ * minijail_cgroup_v2_parent()) through cgroup.freeze. Neither call waits for
+ * the change to take effect; the "frozen" entry in the cgroup's cgroup.events
+ * file reports when it has.
+ *
+ * Returns 0 on success.
+ */
+int minijail_freeze(struct minijail *j);
+int minijail_thaw(struct minijail *j);
+
 /*
  * Wait for all processes in the specified minijail to exit. Returns the exit
  * status of the _first_ process spawned in the jail.
  */
 int minijail_wait(struct minijail *j);
 
+/*
+ * Like minijail_wait(), and also stores the final values of the jail's
+ * counters (see minijail_use_counters()) in @counters.
+ */
+int minijail_wait_counters(struct minijail *j,
+			   struct minijail_counters *counters);
+
+/*
+ * minijail_wait_ready: waits up to @timeout_ms, or forever if negative, for
+ * the service launched from @j to send READY=1 on its minijail_notify_socket().
+ * Only messages from the jail count: its init, the rest of its pid namespace,
+ * or its cgroup. Doesn't reap the jail.
+ *
+ * Returns 0 once it's ready, -ETIMEDOUT, or -ECHILD if the jail exited first.
+ */
+int minijail_wait_ready(struct minijail *j, int timeout_ms);
+
+/*
+ * minijail_write_profile: writes @j, including its compiled seccomp filter,
+ * to @fd as a compiled profile that minijail_read_profile() can load without
+ * parsing or compiling anything. Profiles only load into the same build of
+ * the library. Jails that enter namespaces by path can't be stored.
+ *
+ * Returns 0 on success.
+ */
+int minijail_write_profile(const struct minijail *j, int fd);
+/*
+ * minijail_read_profile: loads the compiled profile at @path into @j, which
+ * must come straight from minijail_new().
+ *
+ * Returns 0 on success, -EINVAL for profiles from other builds.
+ */
+int minijail_read_profile(struct minijail *j, const char *path);
+
+/*
+ * minijail_save_state: writes what a supervisor needs to keep looking after
+ * the running jail @j to @fd, e.g. a memfd or file that outlives an
+ * execve(2) of the supervisor into a newer build of itself. The state refers
+ * to copies of the jail's notification socket and counter fds that survive
+ * the execve(2), so the execve(2) should follow right after. Jails launched
+ * in between don't inherit the copies, and minijail_adopt() makes them
+ * close-on-exec again.
+ *
+ * Returns 0 on success, -EINVAL if @j hasn't been run.
+ */
+int minijail_save_state(const struct minijail *j, int fd);
+/*
+ * minijail_adopt: rebuilds a jail from the state saved at the start of @fd,
+ * after checking that its init is still the same process. Since execve(2)
+ * keeps children, an adopted jail can be waited for, killed, frozen and
+ * accounted for as before; it can't be launched again.
+ *
+ * Returns the jail, or NULL with errno set to ESRCH if it has exited or
+ * EINVAL if the state is malformed.
+ */
+struct minijail *minijail_adopt(int fd);
+
+/*
+ * Frees everything in the given minijail that is only needed to launch it,
+ * like the seccomp filter, mounts and id maps, and returns the freed memory
+ * to the kernel. Waiting for, killing and accounting for the jail keep
+ * working; launching it again does not. For supervisors that sit in
+ * minijail_wait() for the life of the jail.
+ */
+void minijail_trim(struct minijail *j);
+
+enum minijail_log_backend {
+	MINIJAIL_LOG_TO_SYSLOG = 0,
+	MINIJAIL_LOG_TO_FD,
+	MINIJAIL_LOG_TO_RING,
+};
+
+/*
+ * minijail_set_logging: chooses where the library's messages go, for this
+ * process and the jails it launches from now on.
+ * MINIJAIL_LOG_TO_SYSLOG is the default.
+ * MINIJAIL_LOG_TO_FD writes one "<priority>message" line per message to @fd.
+ *   Jails with minijail_close_open_fds() keep @fd until their execve(2).
+ * MINIJAIL_LOG_TO_RING keeps the most recent messages in memory shared with
+ *   the jails, for the caller to collect with minijail_drain_log().
+ * The fd and ring backends don't take locks or allocate, so messages from the
+ * child between fork and exec can't deadlock. Programs that
+ * libminijailpreload.so jails still log to syslog once they've exec'd.
+ *
+ * Returns 0 on success.
+ */
+int minijail_set_logging(enum minijail_log_backend backend, int fd);
+/*
+ * minijail_drain_log: copies the messages logged to the ring since the last
+ * call, one per line, into @buf. Messages that were overwritten before being
+ * drained are skipped.
+ *
+ * Returns the number of bytes written, or -EINVAL if the ring isn't in use.
+ */
+ssize_t minijail_drain_log(char *buf, size_t size);
+
 /*
  * Frees the given minijail. It does not matter if the process is inside the
  * minijail or not.
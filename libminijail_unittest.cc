@@ -18,10 +18,22 @@
 #include <errno.h>
 
 #include <fcntl.h>
+#include <net/if.h>
 #include <sys/types.h>
+#include <sys/capability.h>
+#include <sys/ioctl.h>
+#include <sys/mount.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 
+#include <set>
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include "libminijail.h"
@@ -158,6 +170,781 @@ TEST_F(MarshalTest, 0xff) {
   EXPECT_EQ(-EINVAL, minijail_unmarshal(j_, buf_, sizeof(buf_)));
 }
 
+TEST_F(MarshalTest, cgroup_v2) {
+  ASSERT_EQ(0, minijail_cgroup_v2_parent(m_, "/sys/fs/cgroup/jails"));
+  ASSERT_EQ(0, minijail_cgroup_v2_io_max(m_, "8:0 rbps=1048576"));
+  ASSERT_EQ(0, minijail_cgroup_v2_io_max(m_, "8:16 wiops=120"));
+  ASSERT_EQ(0, minijail_cgroup_v2_pids_max(m_, 64));
+  size_ = minijail_size(m_);
+  ASSERT_EQ(0, minijail_marshal(m_, buf_, sizeof(buf_)));
+  EXPECT_EQ(0, minijail_unmarshal(j_, buf_, size_));
+  EXPECT_EQ(size_, minijail_size(j_));
+
+  struct minijail *k = minijail_new();
+  EXPECT_EQ(-EINVAL, minijail_unmarshal(k, buf_, size_ - 1));
+  minijail_destroy(k);
+}
+
+/* Returns everything minijail_marshal() writes after the jail struct. */
+static std::string marshalled_tail(const struct minijail *j) {
+  struct minijail *empty = minijail_new();
+  /* A fresh jail marshals to just its struct. */
+  size_t struct_size = minijail_size(empty);
+  minijail_destroy(empty);
+  std::string buf(minijail_size(j), '\0');
+  if (minijail_marshal(j, &buf[0], buf.size()))
+    return std::string();
+  return buf.substr(struct_size);
+}
+
+/* Returns the mount(2) options for the /tmp of |j|. */
+static std::string tmpfs_data(const struct minijail *j) {
+  char buf[256];
+  if (minijail_tmpfs_data(j, buf, sizeof(buf)))
+    return std::string();
+  return buf;
+}
+
+TEST(Test, profile_round_trip) {
+  struct minijail *j = minijail_new();
+  char path[] = "/tmp/minijail_profile_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  int policy[2];
+  const char kPolicy[] = "read: 1\nwrite: 1\nexit: 1\n";
+  ASSERT_EQ(0, pipe(policy));
+  ASSERT_EQ((ssize_t)strlen(kPolicy),
+            write(policy[1], kPolicy, strlen(kPolicy)));
+  close(policy[1]);
+
+  minijail_namespace_uts(j);
+  ASSERT_EQ(0, minijail_namespace_set_hostname(j, "jail"));
+  ASSERT_EQ(0, minijail_cgroup_v2_parent(j, "/sys/fs/cgroup/jails"));
+  minijail_write_pid_file(j, "/run/jail.pid");
+  minijail_namespace_vfs(j);
+  ASSERT_EQ(0, minijail_enter_chroot(j, "/var/empty"));
+  ASSERT_EQ(0, minijail_bind(j, "/bin", "/bin", 0));
+  ASSERT_EQ(0, minijail_mount_tmp_opts(j, 1 << 20, "nr_inodes=64"));
+  minijail_no_new_privs(j);
+  minijail_use_seccomp_filter(j);
+  minijail_parse_seccomp_filters_from_fd(j, policy[0]);
+  ASSERT_EQ(0, minijail_write_profile(j, fd));
+
+  /*
+   * The loaded jail has the same settings, strings, mounts and filter
+   * program.
+   */
+  struct minijail *k = minijail_new();
+  EXPECT_EQ(0, minijail_read_profile(k, path));
+  EXPECT_EQ(minijail_size(j), minijail_size(k));
+  EXPECT_EQ(marshalled_tail(j), marshalled_tail(k));
+  EXPECT_NE(std::string::npos, marshalled_tail(k).find("/var/empty"));
+  EXPECT_EQ(1, minijail_has_root(k));
+  EXPECT_EQ(1, minijail_has_mount_ns(k));
+  EXPECT_EQ(tmpfs_data(j), tmpfs_data(k));
+  char *original = minijail_get_original_path(k, "/bin/sh");
+  ASSERT_NE(nullptr, original);
+  EXPECT_STREQ("/bin//sh", original);
+  free(original);
+  original = minijail_get_original_path(k, "/etc/passwd");
+  ASSERT_NE(nullptr, original);
+  EXPECT_STREQ("/var/empty//etc/passwd", original);
+  free(original);
+  minijail_destroy(k);
+
+  /* Truncated profiles are rejected. */
+  ASSERT_EQ(0, ftruncate(fd, 16));
+  k = minijail_new();
+  EXPECT_EQ(-EINVAL, minijail_read_profile(k, path));
+  minijail_destroy(k);
+
+  close(fd);
+  unlink(path);
+  minijail_destroy(j);
+}
+
+TEST(Test, cgroup_v2_limits) {
+  struct minijail *j = minijail_new();
+
+  EXPECT_EQ(0, minijail_cgroup_v2_cpu_max(j, 50000, 100000));
+  EXPECT_EQ(-EINVAL, minijail_cgroup_v2_cpu_max(j, 50000, 10));
+  EXPECT_EQ(-EINVAL, minijail_cgroup_v2_cpu_max(j, 0, 100000));
+  EXPECT_EQ(-EINVAL, minijail_cgroup_v2_cpu_max(j, 999, 100000));
+  EXPECT_EQ(0, minijail_cgroup_v2_cpu_max(j, 1000, 100000));
+  EXPECT_EQ(0, minijail_cgroup_v2_cpu_weight(j, 100));
+  EXPECT_EQ(-EINVAL, minijail_cgroup_v2_cpu_weight(j, 10001));
+  EXPECT_EQ(-EINVAL, minijail_cgroup_v2_memory_max(j, 0));
+  EXPECT_EQ(-EINVAL, minijail_cgroup_v2_io_max(j, "8:0 rbps=1\n8:1"));
+  EXPECT_EQ(0, minijail_cgroup_v2_parent(j, "/sys/fs/cgroup/a"));
+  EXPECT_EQ(-EINVAL, minijail_cgroup_v2_parent(j, "/sys/fs/cgroup/b"));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, pressure_without_cgroup) {
+  struct minijail *j = minijail_new();
+  struct minijail_pressure pressure;
+
+  /* Pressure can only be monitored on a running jail's own cgroup. */
+  EXPECT_EQ(-EINVAL, minijail_pressure_trigger(j, MINIJAIL_PRESSURE_MEMORY, 0,
+                                               100000, 1000000));
+  EXPECT_EQ(-EINVAL,
+            minijail_pressure_snapshot(j, MINIJAIL_PRESSURE_CPU, &pressure));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, kill_tree_without_cgroup) {
+  struct minijail *j = minijail_new();
+
+  /* Without a cgroup or a pid namespace, the jail's tree is unknown. */
+  EXPECT_EQ(-EINVAL, minijail_kill_tree(j));
+  EXPECT_EQ(-EINVAL, minijail_freeze(j));
+  EXPECT_EQ(-EINVAL, minijail_thaw(j));
+
+  minijail_destroy(j);
+}
+
+/* Returns the fds open in this process. */
+static std::set<int> open_fds() {
+  std::set<int> fds;
+  for (int fd = 0; fd < 1024; fd++) {
+    if (fcntl(fd, F_GETFD) >= 0)
+      fds.insert(fd);
+  }
+  return fds;
+}
+
+TEST(Test, read_counters_without_use_counters) {
+  struct minijail *j = minijail_new();
+  struct minijail_counters counters;
+
+  EXPECT_EQ(-EINVAL, minijail_read_counters(j, &counters, NULL));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, read_counters) {
+  char *argv[] = {const_cast<char *>("/bin/true"), NULL};
+  struct minijail *j = minijail_new();
+  struct minijail_counters counters, delta;
+  const uint32_t kPageFaults = 1U << MINIJAIL_COUNTER_PAGE_FAULTS;
+
+  minijail_use_counters(j);
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+  ASSERT_EQ(0, minijail_read_counters(j, &counters, &delta));
+  /* Loading a program always faults in some pages. */
+  ASSERT_TRUE(counters.valid & kPageFaults);
+  EXPECT_GT(counters.value[MINIJAIL_COUNTER_PAGE_FAULTS], 0U);
+  EXPECT_EQ(counters.value[MINIJAIL_COUNTER_PAGE_FAULTS],
+            delta.value[MINIJAIL_COUNTER_PAGE_FAULTS]);
+
+  /* A second run replaces the counters rather than adding to the fds. */
+  std::set<int> before = open_fds();
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+  EXPECT_EQ(before, open_fds());
+  ASSERT_EQ(0, minijail_read_counters(j, &counters, &delta));
+  EXPECT_TRUE(delta.valid & kPageFaults);
+  EXPECT_EQ(counters.value[MINIJAIL_COUNTER_PAGE_FAULTS],
+            delta.value[MINIJAIL_COUNTER_PAGE_FAULTS]);
+
+  minijail_destroy(j);
+}
+
+TEST(Test, dump_syscall_profile_without_profiling) {
+  struct minijail *j = minijail_new();
+
+  EXPECT_EQ(-EINVAL, minijail_dump_syscall_profile(j, STDOUT_FILENO, 0));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, veth_options) {
+  struct minijail *j = minijail_new();
+
+  EXPECT_EQ(-EINVAL, minijail_veth(j, "", "eth0"));
+  EXPECT_EQ(-EINVAL, minijail_veth(j, "veth-host-name-too-long", "eth0"));
+  EXPECT_EQ(0, minijail_veth(j, "veth0", "eth0"));
+
+  EXPECT_EQ(0, minijail_veth_addrs(j, "10.0.0.1/24", "10.0.0.2/24"));
+  EXPECT_EQ(-EINVAL, minijail_veth_addrs(j, "10.0.0.1/24", "10.0.0.2/16"));
+  EXPECT_EQ(-EINVAL, minijail_veth_addrs(j, "10.0.0.1", "10.0.0.2"));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, parse_ipv4_prefix) {
+  struct in_addr addr;
+  int prefixlen;
+
+  EXPECT_EQ(0, parse_ipv4_prefix("192.168.1.1/24", &addr, &prefixlen));
+  EXPECT_EQ(htonl(0xc0a80101), addr.s_addr);
+  EXPECT_EQ(24, prefixlen);
+  EXPECT_EQ(0, parse_ipv4_prefix("0.0.0.0/0", &addr, &prefixlen));
+  EXPECT_EQ(0, prefixlen);
+
+  EXPECT_EQ(-EINVAL, parse_ipv4_prefix("192.168.1.1", &addr, &prefixlen));
+  EXPECT_EQ(-EINVAL, parse_ipv4_prefix("192.168.1.1/", &addr, &prefixlen));
+  EXPECT_EQ(-EINVAL, parse_ipv4_prefix("192.168.1.1/33", &addr, &prefixlen));
+  EXPECT_EQ(-EINVAL, parse_ipv4_prefix("192.168.1/24", &addr, &prefixlen));
+  EXPECT_EQ(-EINVAL, parse_ipv4_prefix("::1/64", &addr, &prefixlen));
+}
+
+TEST(Test, restrict_fs_options) {
+  struct minijail *j = minijail_new();
+
+  EXPECT_EQ(-EINVAL, minijail_restrict_fs(j, "/", 0));
+  EXPECT_EQ(-EINVAL, minijail_restrict_fs(j, "/", 1 << 8));
+  /* Without Landlock these only warn. */
+  EXPECT_EQ(0, minijail_restrict_fs(j, "/", MINIJAIL_FS_READ |
+                                               MINIJAIL_FS_EXEC));
+  EXPECT_EQ(0, minijail_restrict_fs(j, kShellPath, MINIJAIL_FS_READ |
+                                                       MINIJAIL_FS_WRITE));
+  minijail_destroy(j);
+}
+
+static int open_denied(void *context) {
+  int fd = open(static_cast<const char *>(context), O_RDONLY | O_CLOEXEC);
+  if (fd >= 0) {
+    close(fd);
+    return -EEXIST;
+  }
+  return errno == EACCES ? 0 : -errno;
+}
+
+TEST(Test, restrict_fs_applied) {
+  char *argv[] = {const_cast<char *>("/bin/true"), NULL};
+  char outside[] = "/etc/passwd";
+  const char *allowed[] = {"/usr", "/lib", "/lib64", "/bin"};
+  struct minijail *j;
+
+  /* Kernels without Landlock don't restrict anything. */
+  if (syscall(SYS_landlock_create_ruleset, NULL, 0,
+              1 /* LANDLOCK_CREATE_RULESET_VERSION */) < 1) {
+    return;
+  }
+
+  j = minijail_new();
+  for (const char *path : allowed) {
+    if (access(path, F_OK) == 0) {
+      ASSERT_EQ(0, minijail_restrict_fs(j, path, MINIJAIL_FS_READ |
+                                                     MINIJAIL_FS_EXEC));
+    }
+  }
+  /* The hook runs in the jail just before execve(2), under Landlock. */
+  ASSERT_EQ(0, minijail_add_hook(j, open_denied, outside,
+                                 MINIJAIL_HOOK_EVENT_PRE_EXECVE));
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+
+  minijail_destroy(j);
+}
+
+static int drop_sys_admin(void * /* context */) {
+  cap_t caps = cap_get_proc();
+  cap_value_t sys_admin = CAP_SYS_ADMIN;
+  int ret;
+
+  if (!caps)
+    return -errno;
+  ret = cap_set_flag(caps, CAP_EFFECTIVE, 1, &sys_admin, CAP_CLEAR) ||
+                cap_set_proc(caps)
+            ? -errno
+            : 0;
+  cap_free(caps);
+  return ret;
+}
+
+static int open_denied_without_privs(void *context) {
+  if (prctl(PR_GET_NO_NEW_PRIVS, 0, 0, 0, 0) != 1)
+    return -EPERM;
+  return open_denied(context);
+}
+
+TEST(Test, restrict_fs_without_sys_admin) {
+  char *argv[] = {const_cast<char *>("/bin/true"), NULL};
+  char outside[] = "/etc/passwd";
+  const char *allowed[] = {"/usr", "/lib", "/lib64", "/bin"};
+  struct minijail *j;
+
+  if (syscall(SYS_landlock_create_ruleset, NULL, 0,
+              1 /* LANDLOCK_CREATE_RULESET_VERSION */) < 1) {
+    return;
+  }
+
+  j = minijail_new();
+  for (const char *path : allowed) {
+    if (access(path, F_OK) == 0) {
+      ASSERT_EQ(0, minijail_restrict_fs(j, path, MINIJAIL_FS_READ |
+                                                     MINIJAIL_FS_EXEC));
+    }
+  }
+  /* Landlock then needs no_new_privs, which the jail didn't ask for. */
+  ASSERT_EQ(0, minijail_add_hook(j, drop_sys_admin, NULL,
+                                 MINIJAIL_HOOK_EVENT_PRE_DROP_CAPS));
+  ASSERT_EQ(0, minijail_add_hook(j, open_denied_without_privs, outside,
+                                 MINIJAIL_HOOK_EVENT_PRE_EXECVE));
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+
+  minijail_destroy(j);
+}
+
+/* Checks that the hostname is |context| and that loopback is up. */
+static int namespaces_set_up(void *context) {
+  char hostname[64];
+  struct ifreq ifr = {};
+  int fd, ret;
+
+  if (gethostname(hostname, sizeof(hostname)))
+    return -errno;
+  if (strcmp(hostname, static_cast<const char *>(context)))
+    return -EINVAL;
+
+  fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return -errno;
+  strcpy(ifr.ifr_name, "lo");
+  ret = ioctl(fd, SIOCGIFFLAGS, &ifr) ? -errno : 0;
+  close(fd);
+  if (ret == 0 && !(ifr.ifr_flags & IFF_UP))
+    ret = -ENETDOWN;
+  return ret;
+}
+
+TEST(Test, namespaces_applied) {
+  char *argv[] = {const_cast<char *>("/bin/true"), NULL};
+  char hostname[] = "jail";
+
+  /* Unshared after fork(2), and created by clone(2) along with the pid ns. */
+  for (int pids = 0; pids < 2; pids++) {
+    struct minijail *j = minijail_new();
+
+    minijail_namespace_vfs(j);
+    minijail_namespace_uts(j);
+    ASSERT_EQ(0, minijail_namespace_set_hostname(j, hostname));
+    minijail_namespace_net(j);
+    minijail_namespace_ipc(j);
+    if (pids)
+      minijail_namespace_pids(j);
+    ASSERT_EQ(0, minijail_add_hook(j, namespaces_set_up, hostname,
+                                   MINIJAIL_HOOK_EVENT_PRE_EXECVE));
+    ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+    EXPECT_EQ(0, minijail_wait(j)) << "pid namespace: " << pids;
+
+    minijail_destroy(j);
+  }
+}
+
+/* Runs |argv| in |j| and returns what it wrote to stdout. */
+static std::string run_and_read_stdout(struct minijail *j, char *const argv[]) {
+  std::string output;
+  char buf[256];
+  ssize_t n;
+  pid_t pid;
+  int child_stdout;
+  int status;
+
+  if (minijail_run_pid_pipes_no_preload(j, argv[0], argv, &pid, NULL,
+                                        &child_stdout, NULL)) {
+    return output;
+  }
+  while ((n = read(child_stdout, buf, sizeof(buf))) > 0)
+    output.append(buf, n);
+  close(child_stdout);
+  waitpid(pid, &status, 0);
+  return output;
+}
+
+TEST(Test, group_shares_namespaces) {
+  char *argv[] = {const_cast<char *>(kShellPath), const_cast<char *>("-c"),
+                  const_cast<char *>(
+                      "readlink /proc/self/ns/net /proc/self/ns/ipc"),
+                  NULL};
+  struct minijail_group *group;
+
+  EXPECT_EQ(nullptr, minijail_group_new(0));
+  EXPECT_EQ(EINVAL, errno);
+
+  /* Creating the namespaces needs CAP_SYS_ADMIN. */
+  group = minijail_group_new(MINIJAIL_GROUP_NET | MINIJAIL_GROUP_IPC);
+  if (!group)
+    return;
+
+  struct minijail *first = minijail_new();
+  struct minijail *second = minijail_new();
+  struct minijail *outsider = minijail_new();
+  ASSERT_EQ(0, minijail_group_add(group, first));
+  ASSERT_EQ(0, minijail_group_add(group, second));
+
+  std::string first_ns = run_and_read_stdout(first, argv);
+  std::string second_ns = run_and_read_stdout(second, argv);
+  std::string host_ns = run_and_read_stdout(outsider, argv);
+  EXPECT_NE(std::string::npos, first_ns.find("net:["));
+  EXPECT_NE(std::string::npos, first_ns.find("ipc:["));
+  EXPECT_EQ(first_ns, second_ns);
+  EXPECT_NE(host_ns, first_ns);
+
+  minijail_destroy(first);
+  minijail_destroy(second);
+  minijail_destroy(outsider);
+  minijail_group_destroy(group);
+}
+
+TEST(Test, ready_notification) {
+  const char ready[] = "STATUS=Serving\nREADY=1";
+  const char not_ready[] = "READY=10\nSTATUS=READY=1";
+
+  EXPECT_EQ(1, is_ready_notification(ready, strlen(ready)));
+  EXPECT_EQ(0, is_ready_notification(ready, strlen(ready) - 1));
+  EXPECT_EQ(0, is_ready_notification(not_ready, strlen(not_ready)));
+
+  struct minijail *j = minijail_new();
+  EXPECT_EQ(-EINVAL, minijail_wait_ready(j, 0));
+  EXPECT_EQ(-EINVAL, minijail_notify_socket(j, ""));
+  minijail_destroy(j);
+}
+
+/* Sends READY=1 to the notify socket at |context|, as sd_notify(3) would. */
+static int send_ready(void *context) {
+  const char *path = static_cast<const char *>(context);
+  struct sockaddr_un addr = {};
+  int fd, ret;
+
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return -errno;
+  ret = sendto(fd, "READY=1", 7, 0, (struct sockaddr *)&addr, sizeof(addr));
+  ret = ret < 0 ? -errno : 0;
+  close(fd);
+  return ret;
+}
+
+TEST(Test, notify_socket_senders) {
+  char *argv[] = {const_cast<char *>("/bin/sleep"), const_cast<char *>("1"),
+                  NULL};
+  char dir[] = "/tmp/minijail_notify_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(dir));
+  std::string path = std::string(dir) + "/notify";
+  struct minijail *j = minijail_new();
+  int fd;
+
+  /* Anything but a stale socket stays put. */
+  fd = open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0600);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  EXPECT_EQ(-EEXIST, minijail_notify_socket(j, path.c_str()));
+  EXPECT_EQ(0, access(path.c_str(), F_OK));
+  ASSERT_EQ(0, unlink(path.c_str()));
+
+  /* We're not in the jail, so our READY=1 doesn't count. */
+  ASSERT_EQ(0, minijail_notify_socket(j, path.c_str()));
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  ASSERT_EQ(0, send_ready(const_cast<char *>(path.c_str())));
+  EXPECT_EQ(-ETIMEDOUT, minijail_wait_ready(j, 200));
+  minijail_kill(j);
+  minijail_destroy(j);
+
+  /*
+   * The jailed process itself is, and so is the child that init forks off
+   * in a pid namespace. The stale socket gets replaced.
+   */
+  for (int pids = 0; pids < 2; pids++) {
+    j = minijail_new();
+    if (pids)
+      minijail_namespace_pids(j);
+    ASSERT_EQ(0, minijail_notify_socket(j, path.c_str()));
+    ASSERT_EQ(0, minijail_add_hook(j, send_ready,
+                                   const_cast<char *>(path.c_str()),
+                                   MINIJAIL_HOOK_EVENT_PRE_EXECVE));
+    ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+    EXPECT_EQ(0, minijail_wait_ready(j, 5000)) << "pid namespace: " << pids;
+    EXPECT_EQ(0, minijail_wait(j));
+    minijail_destroy(j);
+  }
+
+  unlink(path.c_str());
+  rmdir(dir);
+}
+
+TEST(Test, trim_then_destroy) {
+  struct minijail *j = minijail_new();
+
+  minijail_namespace_uts(j);
+  ASSERT_EQ(0, minijail_namespace_set_hostname(j, "jail"));
+  ASSERT_EQ(0, minijail_bind(j, "/", "/", 0));
+  ASSERT_EQ(0, minijail_cgroup_v2_parent(j, "/sys/fs/cgroup"));
+
+  /* Trimming twice, then destroying, must not double free. */
+  minijail_trim(j);
+  minijail_trim(j);
+  minijail_destroy(j);
+}
+
+TEST(Test, logging_backends) {
+  int fds[2];
+  char buf[1024];
+  ssize_t len;
+
+  ASSERT_EQ(0, pipe(fds));
+  ASSERT_EQ(0, minijail_set_logging(MINIJAIL_LOG_TO_FD, fds[1]));
+  warn("to fd %d", 1);
+  len = read(fds[0], buf, sizeof(buf) - 1);
+  ASSERT_GT(len, 0);
+  buf[len] = '\0';
+  EXPECT_EQ(0, strncmp(buf, "<4>libminijail[", strlen("<4>libminijail[")));
+  EXPECT_NE(nullptr, strstr(buf, "to fd 1\n"));
+  close(fds[0]);
+  close(fds[1]);
+
+  /* The ring collects messages from forked children too. */
+  ASSERT_EQ(0, minijail_set_logging(MINIJAIL_LOG_TO_RING, -1));
+  EXPECT_EQ(0, minijail_drain_log(buf, sizeof(buf)));
+  info("from parent");
+  pid_t pid = fork();
+  if (pid == 0) {
+    warn("from child");
+    _exit(0);
+  }
+  ASSERT_GT(pid, 0);
+  ASSERT_EQ(pid, waitpid(pid, NULL, 0));
+  len = minijail_drain_log(buf, sizeof(buf) - 1);
+  ASSERT_GT(len, 0);
+  buf[len] = '\0';
+  EXPECT_NE(nullptr, strstr(buf, "<6>libminijail["));
+  EXPECT_NE(nullptr, strstr(buf, "from parent\n"));
+  EXPECT_NE(nullptr, strstr(buf, "from child\n"));
+  EXPECT_EQ(0, minijail_drain_log(buf, sizeof(buf)));
+
+  EXPECT_EQ(-EINVAL, minijail_set_logging(MINIJAIL_LOG_TO_FD, -1));
+  EXPECT_EQ(0, minijail_set_logging(MINIJAIL_LOG_TO_SYSLOG, -1));
+}
+
+TEST(Test, log_fd_with_closed_fds) {
+  char *missing_argv[] = {const_cast<char *>("/nonexistent"), NULL};
+  char script[64];
+  char *check_argv[] = {const_cast<char *>(kShellPath),
+                        const_cast<char *>("-c"), script, NULL};
+  int fds[2];
+  char buf[1024];
+  ssize_t len;
+
+  /* Not close-on-exec, like stderr. */
+  ASSERT_EQ(0, pipe(fds));
+  ASSERT_EQ(0, minijail_set_logging(MINIJAIL_LOG_TO_FD, fds[1]));
+
+  /* The child can still report why it failed... */
+  struct minijail *j = minijail_new();
+  minijail_close_open_fds(j);
+  ASSERT_EQ(0, minijail_run_no_preload(j, missing_argv[0], missing_argv));
+  EXPECT_NE(0, minijail_wait(j));
+  minijail_destroy(j);
+  len = read(fds[0], buf, sizeof(buf) - 1);
+  ASSERT_GT(len, 0);
+  buf[len] = '\0';
+  EXPECT_NE(nullptr, strstr(buf, "execve(/nonexistent) failed"));
+
+  /* ...but the program doesn't get the log fd. */
+  j = minijail_new();
+  minijail_close_open_fds(j);
+  snprintf(script, sizeof(script),
+           "[ -e /proc/self/fd/%d ] && echo yes || echo no", fds[1]);
+  EXPECT_EQ("no\n", run_and_read_stdout(j, check_argv));
+  minijail_destroy(j);
+
+  EXPECT_EQ(0, minijail_set_logging(MINIJAIL_LOG_TO_SYSLOG, -1));
+  close(fds[0]);
+  close(fds[1]);
+}
+
+TEST(Test, core_dump_options) {
+  char *argv[] = {const_cast<char *>(kShellPath), const_cast<char *>("-c"),
+                  const_cast<char *>("exit 0"), NULL};
+  struct minijail *j = minijail_new();
+
+  minijail_set_dumpable(j, 1);
+  /* execve(2) would reset it. */
+  EXPECT_EQ(-EINVAL, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(-ERANGE, minijail_set_core_limit(j, 1ULL << 33));
+  EXPECT_EQ(0, minijail_set_core_limit(j, 1 << 20));
+  /* Like any rlimit, it can only be set once. */
+  EXPECT_EQ(-EEXIST, minijail_set_core_limit(j, 0));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, tmpfs_options) {
+  struct minijail *j = minijail_new();
+
+  EXPECT_EQ(-EINVAL, minijail_reset_tmp(j));
+  EXPECT_EQ(-EINVAL, minijail_mount_tmp_opts(j, 1 << 20, "huge=sometimes"));
+  EXPECT_EQ(-EINVAL, minijail_mount_tmp_opts(j, 1 << 20, "mpol=bind"));
+  EXPECT_EQ(-EINVAL, minijail_mount_tmp_opts(j, 1 << 20, "mpol=local:0"));
+  EXPECT_EQ(-EINVAL, minijail_mount_tmp_opts(j, 1 << 20, "nr_inodes=0"));
+  EXPECT_EQ(-EINVAL, minijail_mount_tmp_opts(j, 1 << 20, "uid=0"));
+
+  /* Nodes 2-3 may not exist here, so this one can't be mounted. */
+  EXPECT_EQ(0, minijail_mount_tmp_opts(j, 1 << 20, "mpol=bind:0,2-3"));
+  char data[128];
+  ASSERT_EQ(0, minijail_tmpfs_data(j, data, sizeof(data)));
+  EXPECT_STREQ("size=1048576,mode=1777,mpol=bind:0,2-3", data);
+  /* Not running yet. */
+  EXPECT_EQ(-ESRCH, minijail_reset_tmp(j));
+
+  minijail_destroy(j);
+}
+
+/* Checks that /tmp is a tmpfs mounted with each of the options in |context|. */
+static int tmp_mounted_with(void *context) {
+  char line[512];
+  char opts[512];
+  int ret = -ENOENT;
+  FILE *mounts = fopen("/proc/self/mounts", "re");
+
+  if (!mounts)
+    return -errno;
+  while (fgets(line, sizeof(line), mounts)) {
+    if (sscanf(line, "%*s /tmp tmpfs %511s", opts) != 1)
+      continue;
+    std::string have = std::string(",") + opts + ",";
+    std::string want = static_cast<const char *>(context);
+    size_t pos = 0;
+
+    ret = 0;
+    while (pos <= want.size()) {
+      size_t end = want.find(',', pos);
+      if (end == std::string::npos)
+        end = want.size();
+      if (have.find("," + want.substr(pos, end - pos) + ",") ==
+          std::string::npos) {
+        ret = -EINVAL;
+      }
+      pos = end + 1;
+    }
+  }
+  fclose(mounts);
+  return ret;
+}
+
+TEST(Test, tmpfs_options_applied) {
+  char *argv[] = {const_cast<char *>("/bin/true"), NULL};
+  char expected[] = "size=1024k,nr_inodes=4096,huge=within_size,"
+                    "mpol=bind:0,noswap";
+  struct minijail *j = minijail_new();
+
+  ASSERT_EQ(0, minijail_mount_tmp_opts(
+                   j, 1 << 20, "huge=within_size,mpol=bind:0,noswap,"
+                               "nr_inodes=4K"));
+  ASSERT_EQ(0, minijail_add_hook(j, tmp_mounted_with, expected,
+                                 MINIJAIL_HOOK_EVENT_PRE_EXECVE));
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, optimize_mounts) {
+  struct minijail *j = minijail_new();
+
+  /* Listed before its parent, and already exposed by it. */
+  ASSERT_EQ(0, minijail_mount(j, "/usr/lib", "/usr/lib", "",
+                              MS_BIND | MS_REC));
+  ASSERT_EQ(0, minijail_mount(j, "/usr", "/usr", "", MS_BIND | MS_REC));
+  /* Not recursive, so it hides what the parent exposes beneath it. */
+  ASSERT_EQ(0, minijail_mount(j, "/usr/share", "/usr/share", "", MS_BIND));
+  /* Covered by the tmpfs in between, so it has to stay. */
+  ASSERT_EQ(0, minijail_mount(j, "none", "/usr/local", "tmpfs", 0));
+  ASSERT_EQ(0, minijail_mount(j, "/usr/local/bin", "/usr/local/bin", "",
+                              MS_BIND | MS_REC));
+  ASSERT_EQ(0, minijail_bind(j, "/tmp", "/tmp", 1));
+  ASSERT_EQ(0, minijail_bind(j, "/tmp", "/tmp", 1));
+  /* The second bind undoes the tmpfs, so neither duplicate can go. */
+  ASSERT_EQ(0, minijail_bind(j, "/srv", "/x", 0));
+  ASSERT_EQ(0, minijail_mount(j, "none", "/x", "tmpfs", 0));
+  ASSERT_EQ(0, minijail_bind(j, "/srv", "/x", 0));
+  ASSERT_EQ(0, minijail_bind(j, "/var", "/var", 1));
+  ASSERT_EQ(0, minijail_mount(j, "/var", "/var", "",
+                              MS_BIND | MS_REMOUNT | MS_RDONLY));
+
+  EXPECT_EQ(3, minijail_optimize_mounts(j));
+  EXPECT_EQ(0, minijail_optimize_mounts(j));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, scheduling_options) {
+  struct minijail *j = minijail_new();
+
+  EXPECT_EQ(0, minijail_set_cpu_affinity(j, "0-1,3"));
+  EXPECT_EQ(-EINVAL, minijail_set_cpu_affinity(j, "1-0"));
+  EXPECT_EQ(-ERANGE, minijail_set_cpu_affinity(j, "0-100000"));
+  EXPECT_EQ(0, minijail_set_uclamp(j, 0, 512));
+  EXPECT_EQ(-EINVAL, minijail_set_uclamp(j, 512, 256));
+  EXPECT_EQ(-EINVAL, minijail_set_uclamp(j, 0, 1025));
+  EXPECT_EQ(0, minijail_set_nice(j, 10));
+  EXPECT_EQ(-EINVAL, minijail_set_nice(j, 20));
+  EXPECT_EQ(0, minijail_set_ioprio(j, MINIJAIL_IOPRIO_CLASS_BE, 7));
+  EXPECT_EQ(-EINVAL, minijail_set_ioprio(j, MINIJAIL_IOPRIO_CLASS_BE, 8));
+  EXPECT_EQ(-EINVAL, minijail_set_timerslack(j, 0));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, scheduling_applied) {
+  char *argv[] = {const_cast<char *>(kShellPath), const_cast<char *>("-c"),
+                  const_cast<char *>(
+                      "set -- $(cat /proc/self/stat) && test \"${19}\" = 5 &&"
+                      " test \"$(cat /proc/self/timerslack_ns)\" = 100000"),
+                  NULL};
+  struct minijail *j = minijail_new();
+
+  ASSERT_EQ(0, minijail_set_nice(j, 5));
+  ASSERT_EQ(0, minijail_set_timerslack(j, 100000));
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, memory_policy_applied) {
+  char *argv[] = {const_cast<char *>(kShellPath), const_cast<char *>("-c"),
+                  const_cast<char *>(
+                      "grep -q '^THP_enabled:.*0$' /proc/self/status &&"
+                      " grep -q ' bind:0 ' /proc/self/numa_maps"),
+                  NULL};
+  struct minijail *j = minijail_new();
+
+  ASSERT_EQ(0, minijail_set_mempolicy(j, MINIJAIL_MPOL_BIND, "0"));
+  minijail_set_thp(j, 0);
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+
+  minijail_destroy(j);
+}
+
+TEST(Test, ksm_applied) {
+  char *argv[] = {const_cast<char *>(kShellPath), const_cast<char *>("-c"),
+                  const_cast<char *>(
+                      "grep -q '^ksm_merge_any: yes$' /proc/self/ksm_stat"),
+                  NULL};
+  struct minijail *j;
+
+  /* Kernels without KSM have no ksm_stat. */
+  if (access("/proc/self/ksm_stat", R_OK))
+    return;
+
+  j = minijail_new();
+  minijail_enable_ksm(j);
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+
+  minijail_destroy(j);
+}
+
 TEST(Test, minijail_run_pid_pipes_no_preload) {
   pid_t pid;
   int child_stdin, child_stdout, child_stderr;
@@ -217,6 +1004,210 @@ TEST(Test, minijail_run_pid_pipes_no_preload) {
   minijail_destroy(j);
 }
 
+TEST(Test, run_with_closed_stdio) {
+  char *argv[] = {const_cast<char *>(kShellPath), const_cast<char *>("-c"),
+                  const_cast<char *>("echo test >&2"), NULL};
+  char teststr[] = "test\n";
+  pid_t launcher;
+  int status;
+
+  /*
+   * With stdio closed, the stderr pipe takes fds 0 and 1, and the sync pipe
+   * would take fd 2, which the child points at the stderr pipe.
+   */
+  launcher = fork();
+  ASSERT_GE(launcher, 0);
+  if (launcher == 0) {
+    struct minijail *j = minijail_new();
+    char buf[sizeof(teststr)];
+    int child_stderr;
+    pid_t pid;
+
+    close(STDIN_FILENO);
+    close(STDOUT_FILENO);
+    close(STDERR_FILENO);
+    if (minijail_rlimit(j, RLIMIT_NOFILE, 64, 64) ||
+        minijail_run_pid_pipes_no_preload(j, argv[0], argv, &pid, NULL, NULL,
+                                          &child_stderr)) {
+      _exit(1);
+    }
+    if (read(child_stderr, buf, sizeof(buf)) != (ssize_t)strlen(teststr))
+      _exit(2);
+    _exit(minijail_wait(j));
+  }
+  ASSERT_EQ(launcher, waitpid(launcher, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+}
+
+static int set_hooked_env(void *context) {
+  return setenv("MINIJAIL_HOOKED", static_cast<const char *>(context), 1)
+             ? -errno : 0;
+}
+
+TEST(Test, hooks) {
+  char *argv[] = {const_cast<char *>(kShellPath), const_cast<char *>("-c"),
+                  const_cast<char *>("test \"$MINIJAIL_HOOKED\" = yes"),
+                  NULL};
+  char context[] = "yes";
+  struct minijail *j = minijail_new();
+
+  EXPECT_EQ(-EINVAL, minijail_add_hook(j, set_hooked_env, context,
+                                       MINIJAIL_HOOK_EVENT_MAX));
+  ASSERT_EQ(0, minijail_add_hook(j, set_hooked_env, context,
+                                 MINIJAIL_HOOK_EVENT_PRE_EXECVE));
+  /* The hook can't follow the program through LD_PRELOAD. */
+  EXPECT_EQ(-EINVAL, minijail_run(j, argv[0], argv));
+
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  EXPECT_EQ(0, minijail_wait(j));
+  EXPECT_EQ(nullptr, getenv("MINIJAIL_HOOKED"));
+
+  minijail_destroy(j);
+}
+
+struct hook_mark {
+  int fd;
+  char mark;
+};
+
+/* Records that the hook ran by writing its mark to a pipe. */
+static int write_hook_mark(void *context) {
+  const struct hook_mark *m = static_cast<const struct hook_mark *>(context);
+  return write(m->fd, &m->mark, 1) == 1 ? 0 : -EIO;
+}
+
+static int fail_hook(void * /* context */) {
+  return -EPERM;
+}
+
+TEST(Test, hook_events) {
+  char *argv[] = {const_cast<char *>("/bin/true"), NULL};
+  struct hook_mark marks[MINIJAIL_HOOK_EVENT_MAX];
+  char buf[MINIJAIL_HOOK_EVENT_MAX + 1];
+  struct minijail *j = minijail_new();
+  int fds[2];
+  int event;
+
+  ASSERT_EQ(0, pipe(fds));
+  /* Added in reverse, so the marks only come out in order if the events do. */
+  for (event = MINIJAIL_HOOK_EVENT_MAX - 1; event >= 0; event--) {
+    marks[event].fd = fds[1];
+    marks[event].mark = '0' + event;
+    ASSERT_EQ(0, minijail_add_hook(j, write_hook_mark, &marks[event],
+                                   static_cast<minijail_hook_event>(event)));
+  }
+  ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+  close(fds[1]);
+  EXPECT_EQ(0, minijail_wait(j));
+  ASSERT_EQ(MINIJAIL_HOOK_EVENT_MAX, read(fds[0], buf, sizeof(buf)));
+  buf[MINIJAIL_HOOK_EVENT_MAX] = '\0';
+  EXPECT_STREQ("0123", buf);
+  close(fds[0]);
+  minijail_destroy(j);
+
+  /* A failing hook at any event stops the launch. */
+  for (event = 0; event < MINIJAIL_HOOK_EVENT_MAX; event++) {
+    j = minijail_new();
+    ASSERT_EQ(0, minijail_add_hook(j, fail_hook, NULL,
+                                   static_cast<minijail_hook_event>(event)));
+    ASSERT_EQ(0, minijail_run_no_preload(j, argv[0], argv));
+    EXPECT_NE(0, minijail_wait(j)) << "event " << event;
+    minijail_destroy(j);
+  }
+}
+
+TEST(Test, save_state_and_adopt) {
+  char *argv[4];
+  pid_t pid;
+  int child_stdin;
+  FILE *state = tmpfile();
+  ASSERT_NE(nullptr, state);
+
+  struct minijail *j = minijail_new();
+  EXPECT_EQ(-EINVAL, minijail_save_state(j, fileno(state)));
+
+  argv[0] = (char*)kShellPath;
+  argv[1] = "-c";
+  argv[2] = "read line";
+  argv[3] = NULL;
+  ASSERT_EQ(0, minijail_run_pid_pipes_no_preload(j, argv[0], argv, &pid,
+                                                 &child_stdin, NULL, NULL));
+  ASSERT_EQ(0, minijail_save_state(j, fileno(state)));
+  minijail_destroy(j);
+
+  /* The adopted jail is waited for like the original. */
+  struct minijail *adopted = minijail_adopt(fileno(state));
+  ASSERT_NE(nullptr, adopted);
+  EXPECT_EQ(3, (int)write(child_stdin, "go\n", 3));
+  EXPECT_EQ(0, minijail_wait(adopted));
+  minijail_destroy(adopted);
+  close(child_stdin);
+
+  /* Once the jail is gone, there is nothing to adopt. */
+  errno = 0;
+  EXPECT_EQ(nullptr, minijail_adopt(fileno(state)));
+  EXPECT_EQ(ESRCH, errno);
+  fclose(state);
+}
+
+/* Returns the fds that an execve(2) would keep. */
+static std::set<int> inheritable_fds() {
+  std::set<int> fds;
+  for (int fd = 0; fd < 1024; fd++) {
+    int flags = fcntl(fd, F_GETFD);
+    if (flags >= 0 && !(flags & FD_CLOEXEC))
+      fds.insert(fd);
+  }
+  return fds;
+}
+
+TEST(Test, save_state_keeps_copies) {
+  char *sleep_argv[] = {const_cast<char *>("/bin/sleep"),
+                        const_cast<char *>("1"), NULL};
+  char script[64];
+  char *check_argv[] = {const_cast<char *>(kShellPath),
+                        const_cast<char *>("-c"), script, NULL};
+  char dir[] = "/tmp/minijail_state_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(dir));
+  std::string path = std::string(dir) + "/notify";
+  FILE *state = tmpfile();
+  ASSERT_NE(nullptr, state);
+
+  struct minijail *j = minijail_new();
+  ASSERT_EQ(0, minijail_notify_socket(j, path.c_str()));
+  ASSERT_EQ(0, minijail_run_no_preload(j, sleep_argv[0], sleep_argv));
+  std::set<int> before = inheritable_fds();
+  ASSERT_EQ(0, minijail_save_state(j, fileno(state)));
+
+  /* Only a copy of the notification socket is left open for the exec. */
+  std::set<int> after = inheritable_fds();
+  ASSERT_EQ(before.size() + 1, after.size());
+  int copy = -1;
+  for (int fd : after) {
+    if (!before.count(fd))
+      copy = fd;
+  }
+  ASSERT_GE(copy, 0);
+
+  /* A jail launched before the exec doesn't get it either. */
+  struct minijail *other = minijail_new();
+  snprintf(script, sizeof(script),
+           "[ -e /proc/self/fd/%d ] && echo yes || echo no", copy);
+  EXPECT_EQ("no\n", run_and_read_stdout(other, check_argv));
+  minijail_destroy(other);
+
+  struct minijail *adopted = minijail_adopt(fileno(state));
+  ASSERT_NE(nullptr, adopted);
+  EXPECT_EQ(before, inheritable_fds());
+  minijail_kill(adopted);
+  minijail_destroy(adopted);
+  minijail_destroy(j);
+  fclose(state);
+  unlink(path.c_str());
+  rmdir(dir);
+}
+
 TEST(Test, test_minijail_no_fd_leaks) {
   pid_t pid;
   int child_stdout;
@@ -324,3 +1315,52 @@ TEST(Test, parse_size) {
   ASSERT_EQ(-EINVAL, parse_size(&size, "-1G"));
   ASSERT_EQ(-EINVAL, parse_size(&size, "; /bin/rm -- "));
 }
+
+TEST(Test, path_under) {
+  EXPECT_STREQ("", path_under("/usr", "/usr"));
+  EXPECT_STREQ("/lib", path_under("/usr/", "/usr/lib"));
+  EXPECT_STREQ("/usr/lib", path_under("/", "/usr/lib"));
+  EXPECT_EQ(nullptr, path_under("/usr", "/usrlib"));
+  EXPECT_EQ(nullptr, path_under("/usr/lib", "/usr"));
+
+  EXPECT_EQ(0U, path_depth("/"));
+  EXPECT_EQ(2U, path_depth("/usr//lib/"));
+}
+
+TEST(Test, parse_bitmap_list) {
+  unsigned long mask[2];
+
+  memset(mask, 0, sizeof(mask));
+  ASSERT_EQ(0, parse_bitmap_list(mask, 128, "0-3,8,10-11"));
+  ASSERT_EQ(0xd0fUL, mask[0]);
+  ASSERT_EQ(0UL, mask[1]);
+
+  ASSERT_EQ(0, parse_bitmap_list(mask, 128, "127"));
+  ASSERT_EQ(0UL, mask[0]);
+  ASSERT_EQ(1UL << (127 % (8 * sizeof(unsigned long))),
+            mask[127 / (8 * sizeof(unsigned long))]);
+
+  memset(mask, 0, sizeof(mask));
+  ASSERT_EQ(-ERANGE, parse_bitmap_list(mask, 128, "128"));
+  ASSERT_EQ(-EINVAL, parse_bitmap_list(mask, 128, ""));
+  ASSERT_EQ(-EINVAL, parse_bitmap_list(mask, 128, "1,"));
+  ASSERT_EQ(-EINVAL, parse_bitmap_list(mask, 128, "3-1"));
+  ASSERT_EQ(-EINVAL, parse_bitmap_list(mask, 128, "1-"));
+  ASSERT_EQ(-EINVAL, parse_bitmap_list(mask, 128, "a"));
+  ASSERT_EQ(0UL, mask[0]);
+}
+
+TEST(Test, format_bitmap_list) {
+  unsigned long mask[2];
+  char buf[32];
+
+  memset(mask, 0, sizeof(mask));
+  ASSERT_EQ(0, format_bitmap_list(buf, sizeof(buf), mask, 128));
+  ASSERT_STREQ("", buf);
+
+  ASSERT_EQ(0, parse_bitmap_list(mask, 128, "0-3,8,10-11,127"));
+  ASSERT_EQ(0, format_bitmap_list(buf, sizeof(buf), mask, 128));
+  ASSERT_STREQ("0-3,8,10-11,127", buf);
+
+  ASSERT_EQ(-ENOSPC, format_bitmap_list(buf, 8, mask, 128));
+}
@@ -3,8 +3,14 @@
  * found in the LICENSE file.
  */
 
+#define _GNU_SOURCE
+
 #include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <getopt.h>
+#include <limits.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -122,6 +128,257 @@ static void add_mount(struct minijail *j, char *arg)
 	}
 }
 
+static void set_sched_policy(struct minijail *j, const char *arg)
+{
+	int policy;
+	if (!strcmp(arg, "other"))
+		policy = SCHED_OTHER;
+	else if (!strcmp(arg, "batch"))
+		policy = SCHED_BATCH;
+	else if (!strcmp(arg, "idle"))
+		policy = SCHED_IDLE;
+	else {
+		fprintf(stderr, "Bad scheduling policy: '%s'\n", arg);
+		exit(1);
+	}
+	if (minijail_set_sched_policy(j, policy)) {
+		fprintf(stderr, "minijail_set_sched_policy failed.\n");
+		exit(1);
+	}
+}
+
+static void set_uclamp(struct minijail *j, char *arg)
+{
+	char *min = strtok(arg, ",");
+	char *max = strtok(NULL, ",");
+	char *min_end = NULL, *max_end = NULL;
+	long min_val, max_val;
+	if (!min || !max) {
+		fprintf(stderr, "Bad utilization clamp: '%s'\n", arg);
+		exit(1);
+	}
+	min_val = strtol(min, &min_end, 10);
+	max_val = strtol(max, &max_end, 10);
+	if (*min_end || *max_end || min_val < 0 || max_val < 0 ||
+	    minijail_set_uclamp(j, min_val, max_val)) {
+		fprintf(stderr, "Invalid utilization clamp '%s,%s'.\n", min,
+			max);
+		exit(1);
+	}
+}
+
+static void set_nice(struct minijail *j, const char *arg)
+{
+	char *end = NULL;
+	long nice = strtol(arg, &end, 10);
+	if (*end || !*arg || minijail_set_nice(j, nice)) {
+		fprintf(stderr, "Invalid nice value: '%s'\n", arg);
+		exit(1);
+	}
+}
+
+static void set_ioprio(struct minijail *j, char *arg)
+{
+	char *class = strtok(arg, ",");
+	char *level = strtok(NULL, ",");
+	int ioclass;
+	if (!class) {
+		fprintf(stderr, "Bad I/O priority.\n");
+		exit(1);
+	}
+	if (!strcmp(class, "rt"))
+		ioclass = MINIJAIL_IOPRIO_CLASS_RT;
+	else if (!strcmp(class, "be"))
+		ioclass = MINIJAIL_IOPRIO_CLASS_BE;
+	else if (!strcmp(class, "idle"))
+		ioclass = MINIJAIL_IOPRIO_CLASS_IDLE;
+	else {
+		fprintf(stderr, "Bad I/O priority class: '%s'\n", class);
+		exit(1);
+	}
+	if (minijail_set_ioprio(j, ioclass, level ? atoi(level) : 0)) {
+		fprintf(stderr, "Invalid I/O priority level.\n");
+		exit(1);
+	}
+}
+
+static void set_timerslack(struct minijail *j, const char *arg)
+{
+	char *end = NULL;
+	unsigned long slack = strtoul(arg, &end, 10);
+	if (*end || !*arg || minijail_set_timerslack(j, slack)) {
+		fprintf(stderr, "Invalid timer slack: '%s'\n", arg);
+		exit(1);
+	}
+}
+
+static void set_mempolicy(struct minijail *j, char *arg)
+{
+	char *mode = strtok(arg, ":");
+	char *nodes = strtok(NULL, ":");
+	int mpol;
+	if (!mode || !nodes) {
+		fprintf(stderr, "Bad memory policy.\n");
+		exit(1);
+	}
+	if (!strcmp(mode, "bind"))
+		mpol = MINIJAIL_MPOL_BIND;
+	else if (!strcmp(mode, "preferred"))
+		mpol = MINIJAIL_MPOL_PREFERRED;
+	else if (!strcmp(mode, "interleave"))
+		mpol = MINIJAIL_MPOL_INTERLEAVE;
+	else {
+		fprintf(stderr, "Bad memory policy mode: '%s'\n", mode);
+		exit(1);
+	}
+	if (minijail_set_mempolicy(j, mpol, nodes)) {
+		fprintf(stderr, "Invalid NUMA node list: '%s'\n", nodes);
+		exit(1);
+	}
+}
+
+static void set_oom_score_adj(struct minijail *j, const char *arg)
+{
+	char *end = NULL;
+	long adj = strtol(arg, &end, 10);
+	if (*end || !*arg || minijail_set_oom_score_adj(j, adj)) {
+		fprintf(stderr, "Invalid oom_score_adj: '%s'\n", arg);
+		exit(1);
+	}
+}
+
+static void restrict_fs(struct minijail *j, char *arg)
+{
+	char *access_str = strrchr(arg, ',');
+	int access = 0;
+
+	if (access_str) {
+		*access_str++ = '\0';
+		for (; *access_str; access_str++) {
+			if (*access_str == 'r')
+				access |= MINIJAIL_FS_READ;
+			else if (*access_str == 'w')
+				access |= MINIJAIL_FS_WRITE;
+			else if (*access_str == 'x')
+				access |= MINIJAIL_FS_EXEC;
+			else
+				access = -1;
+			if (access < 0)
+				break;
+		}
+	}
+	if (access <= 0 || !*arg || minijail_restrict_fs(j, arg, access)) {
+		fprintf(stderr, "Bad filesystem restriction: '%s'\n", arg);
+		exit(1);
+	}
+}
+
+static void set_logging(const char *arg)
+{
+	char *end = NULL;
+	int ret;
+
+	if (!strcmp(arg, "syslog")) {
+		ret = minijail_set_logging(MINIJAIL_LOG_TO_SYSLOG, -1);
+	} else if (!strcmp(arg, "stderr")) {
+		ret = minijail_set_logging(MINIJAIL_LOG_TO_FD, STDERR_FILENO);
+	} else if (!strcmp(arg, "ring")) {
+		ret = minijail_set_logging(MINIJAIL_LOG_TO_RING, -1);
+	} else {
+		long fd = strtol(arg, &end, 10);
+		if (*end || !*arg || fd < 0 || fd > INT_MAX)
+			ret = -EINVAL;
+		else
+			ret = minijail_set_logging(MINIJAIL_LOG_TO_FD, fd);
+	}
+	if (ret) {
+		fprintf(stderr, "Invalid logging backend: '%s'\n", arg);
+		exit(1);
+	}
+}
+
+/* Copies whatever the jail left in the log ring to stderr. */
+static void flush_log_ring(void)
+{
+	char buf[4096];
+	ssize_t len;
+
+	while ((len = minijail_drain_log(buf, sizeof(buf))) > 0)
+		fwrite(buf, 1, len, stderr);
+}
+
+static void set_dumpable(struct minijail *j, const char *arg)
+{
+	if (strcmp(arg, "0") && strcmp(arg, "1")) {
+		fprintf(stderr, "Invalid dumpable value: '%s'\n", arg);
+		exit(1);
+	}
+	minijail_set_dumpable(j, arg[0] == '1');
+}
+
+static void set_core_limit(struct minijail *j, const char *arg)
+{
+	size_t bytes;
+	if (parse_size(&bytes, arg) || minijail_set_core_limit(j, bytes)) {
+		fprintf(stderr, "Invalid core limit: '%s'\n", arg);
+		exit(1);
+	}
+}
+
+static void set_veth(struct minijail *j, char *arg)
+{
+	char *host = strtok(arg, ",");
+	char *jail = strtok(NULL, ",");
+	char *host_addr = strtok(NULL, ",");
+	char *jail_addr = strtok(NULL, ",");
+	if (!host || !jail || (host_addr && !jail_addr) ||
+	    minijail_veth(j, host, jail)) {
+		fprintf(stderr, "Bad veth pair.\n");
+		exit(1);
+	}
+	if (host_addr && minijail_veth_addrs(j, host_addr, jail_addr)) {
+		fprintf(stderr, "Bad veth addresses: '%s', '%s'\n", host_addr,
+			jail_addr);
+		exit(1);
+	}
+}
+
+static void load_profile(struct minijail *j, const char *path, int first)
+{
+	int ret;
+	/* The profile replaces the whole jail, so it can't follow overrides. */
+	if (!first) {
+		fprintf(stderr, "--profile must be the first option.\n");
+		exit(1);
+	}
+	ret = minijail_read_profile(j, path);
+	if (ret) {
+		fprintf(stderr, "Could not load profile '%s': %s\n", path,
+			strerror(-ret));
+		exit(1);
+	}
+}
+
+static void compile_profile(struct minijail *j, const char *path)
+{
+	int ret;
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		fprintf(stderr, "Could not open '%s': %s\n", path,
+			strerror(errno));
+		exit(1);
+	}
+	ret = minijail_write_profile(j, fd);
+	close(fd);
+	if (ret) {
+		fprintf(stderr, "Could not compile profile '%s': %s\n", path,
+			strerror(-ret));
+		unlink(path);
+		exit(1);
+	}
+	exit(0);
+}
+
 static char *build_idmap(id_t id, id_t lowerid)
 {
 	int ret;
@@ -211,7 +468,40 @@ static void usage(const char *progn)
 	       "  -Y:           Synchronize seccomp filters across thread group.\n"
 	       "  -z:           Don't forward signals to jailed process.\n"
 	       "  --ambient:    Raise ambient capabilities. Requires -c.\n"
-	       "  --uts[=name]: Enter a new UTS namespace (and set hostname).\n");
+	       "  --uts[=name]: Enter a new UTS namespace (and set hostname).\n"
+	       "  --cpus=<list>: Restrict the jail to the CPUs in <list>, e.g. '0-3,8'.\n"
+	       "  --sched=<policy>: Use scheduling policy 'other', 'batch' or 'idle'.\n"
+	       "  --uclamp=<min>,<max>: Set utilization clamps (0-1024).\n"
+	       "  --nice=<nice>: Set the nice value.\n"
+	       "  --ioprio=<class>[,<level>]: Set I/O priority class 'rt', 'be' or 'idle'\n"
+	       "                and level (0-7).\n"
+	       "  --timerslack=<ns>: Set the timer slack in nanoseconds.\n"
+	       "  --mempolicy=<mode>:<nodes>: Set NUMA memory policy 'bind', 'preferred'\n"
+	       "                or 'interleave' over the nodes in <nodes>, e.g. '0-1'.\n"
+	       "  --thp=<on|off>: Enable or disable transparent huge pages.\n"
+	       "  --oom-score-adj=<adj>: Set the OOM score adjustment (-1000 to 1000).\n"
+	       "  --ksm:        Enable kernel samepage merging for the jail's memory.\n"
+	       "  --veth=<host>,<jail>[,<host addr/len>,<jail addr/len>]:\n"
+	       "                Connect a new network namespace with a veth pair.\n"
+	       "  --lean:       Free everything not needed to supervise the jail once\n"
+	       "                it is running.\n"
+	       "  --compile-profile=<file>: Write the jail described by the other options,\n"
+	       "                with its seccomp filter compiled, to <file> and exit.\n"
+	       "  --profile=<file>: Load a compiled profile. Must be the first option;\n"
+	       "                later options override it.\n"
+	       "  --logging=<syslog|stderr|ring|fd>: Send minijail's own messages to\n"
+	       "                syslog (default), stderr, an in-memory ring printed to\n"
+	       "                stderr on exit, or the already open file descriptor <fd>.\n"
+	       "  --restrict-fs=<path>,<rwx>: Only allow the given mix of read, write\n"
+	       "                and execute access beneath <path>, with Landlock.\n"
+	       "                Can be given more than once. Implies -n without\n"
+	       "                CAP_SYS_ADMIN.\n"
+	       "  --dumpable=<0|1>: Whether the jail dumps core after changing uids.\n"
+	       "  --core-limit=<size>: Cap core dumps at <size> bytes (K/M/G suffixes\n"
+	       "                allowed); 0 turns them off.\n"
+	       "  --tmpfs-opts=<opts>: Extra options for the /tmp tmpfs (implies -t):\n"
+	       "                huge=<mode>, mpol=<mode>:<nodes>, nr_inodes=<n>, noswap.\n"
+	       "  --optimize-mounts: Sort mounts parents first and drop redundant ones.\n");
 	/* clang-format on */
 }
 
@@ -227,7 +517,7 @@ static void seccomp_filter_usage(const char *progn)
 }
 
 static int parse_args(struct minijail *j, int argc, char *argv[],
-		      int *exit_immediately, ElfType *elftype)
+		      int *exit_immediately, int *lean, ElfType *elftype)
 {
 	int opt;
 	int use_seccomp_filter = 0;
@@ -240,8 +530,12 @@ static int parse_args(struct minijail *j, int argc, char *argv[],
 	int seccomp = -1;
 	const size_t path_max = 4096;
 	char *map;
-	size_t size;
-	const char *filter_path;
+	size_t size, tmp_size = 64 * 1024 * 1024;
+	const char *tmpfs_opts = NULL;
+	int optimize_mounts = 0;
+	const char *filter_path = NULL;
+	const char *compiled_profile_path = NULL;
+	int first_option = 1;
 
 	const char *optstring =
 	    "+u:g:sS:c:C:P:b:B:V:f:m::M::k:a:e::R:T:vrGhHinNplLt::IUKwyYz";
@@ -250,6 +544,26 @@ static int parse_args(struct minijail *j, int argc, char *argv[],
 	const struct option long_options[] = {
 		{"ambient", no_argument, 0, 128},
 		{"uts", optional_argument, 0, 129},
+		{"cpus", required_argument, 0, 130},
+		{"sched", required_argument, 0, 131},
+		{"uclamp", required_argument, 0, 132},
+		{"nice", required_argument, 0, 133},
+		{"ioprio", required_argument, 0, 134},
+		{"timerslack", required_argument, 0, 135},
+		{"mempolicy", required_argument, 0, 136},
+		{"thp", required_argument, 0, 137},
+		{"oom-score-adj", required_argument, 0, 138},
+		{"ksm", no_argument, 0, 139},
+		{"veth", required_argument, 0, 140},
+		{"lean", no_argument, 0, 141},
+		{"compile-profile", required_argument, 0, 142},
+		{"profile", required_argument, 0, 143},
+		{"logging", required_argument, 0, 144},
+		{"restrict-fs", required_argument, 0, 145},
+		{"dumpable", required_argument, 0, 146},
+		{"core-limit", required_argument, 0, 147},
+		{"tmpfs-opts", required_argument, 0, 148},
+		{"optimize-mounts", no_argument, 0, 149},
 		{0, 0, 0, 0},
 	};
 	/* clang-format on */
@@ -358,6 +672,7 @@ static int parse_args(struct minijail *j, int argc, char *argv[],
 				exit(1);
 			}
 			minijail_mount_tmp_size(j, size);
+			tmp_size = size;
 			break;
 		case 'v':
 			minijail_namespace_vfs(j);
@@ -498,10 +813,93 @@ static int parse_args(struct minijail *j, int argc, char *argv[],
 			if (optarg)
 				minijail_namespace_set_hostname(j, optarg);
 			break;
+		case 130: /* CPU affinity. */
+			if (minijail_set_cpu_affinity(j, optarg)) {
+				fprintf(stderr, "Invalid CPU list: '%s'\n",
+					optarg);
+				exit(1);
+			}
+			break;
+		case 131: /* Scheduling policy. */
+			set_sched_policy(j, optarg);
+			break;
+		case 132: /* Utilization clamps. */
+			set_uclamp(j, optarg);
+			break;
+		case 133: /* Nice value. */
+			set_nice(j, optarg);
+			break;
+		case 134: /* I/O priority. */
+			set_ioprio(j, optarg);
+			break;
+		case 135: /* Timer slack. */
+			set_timerslack(j, optarg);
+			break;
+		case 136: /* NUMA memory policy. */
+			set_mempolicy(j, optarg);
+			break;
+		case 137: /* Transparent huge pages. */
+			if (!strcmp(optarg, "on"))
+				minijail_set_thp(j, 1);
+			else if (!strcmp(optarg, "off"))
+				minijail_set_thp(j, 0);
+			else {
+				fprintf(stderr, "--thp takes 'on' or 'off'.\n");
+				exit(1);
+			}
+			break;
+		case 138: /* OOM score adjustment. */
+			set_oom_score_adj(j, optarg);
+			break;
+		case 139: /* Kernel samepage merging. */
+			minijail_enable_ksm(j);
+			break;
+		case 140: /* veth pair. */
+			set_veth(j, optarg);
+			break;
+		case 141: /* Minimal supervisor. */
+			*lean = 1;
+			break;
+		case 142: /* Compile a profile. */
+			compiled_profile_path = optarg;
+			break;
+		case 143: /* Load a compiled profile. */
+			load_profile(j, optarg, first_option);
+			/* Later options are checked against what it set up. */
+			chroot = minijail_has_root(j);
+			mount_ns = minijail_has_mount_ns(j);
+			break;
+		case 144: /* Logging backend. */
+			set_logging(optarg);
+			break;
+		case 145: /* Landlock. */
+			restrict_fs(j, optarg);
+			break;
+		case 146: /* Dumpable. */
+			set_dumpable(j, optarg);
+			break;
+		case 147: /* Core dump size. */
+			set_core_limit(j, optarg);
+			break;
+		case 148: /* /tmp tmpfs options. */
+			minijail_namespace_vfs(j);
+			tmpfs_opts = optarg;
+			break;
+		case 149: /* Mount plan optimization. */
+			optimize_mounts = 1;
+			break;
 		default:
 			usage(argv[0]);
 			exit(1);
 		}
+		first_option = 0;
+	}
+
+	/* Applied after the loop so that -t can come before or after it. */
+	if (tmpfs_opts && minijail_mount_tmp_opts(j, tmp_size, tmpfs_opts)) {
+		fprintf(stderr, "Invalid /tmp tmpfs options: '%s'.\n",
+			tmpfs_opts);
+		exit(1);
 	}
 
 	/* Can only set ambient caps when using regular caps. */
@@ -541,6 +939,15 @@ static int parse_args(struct minijail *j, int argc, char *argv[],
 		free((void *)filter_path);
 	}
 
+	/* After the loop, so that every mount option is in the plan. */
+	if (optimize_mounts && minijail_optimize_mounts(j) < 0) {
+		fprintf(stderr, "Could not optimize mounts.\n");
+		exit(1);
+	}
+
+	if (compiled_profile_path)
+		compile_profile(j, compiled_profile_path);
+
 	/*
 	 * There should be at least one additional unparsed argument: the
 	 * executable name.
@@ -592,8 +999,12 @@ int main(int argc, char *argv[])
 	struct minijail *j = minijail_new();
 	const char *dl_mesg = NULL;
 	int exit_immediately = 0;
+	int lean = 0;
+	int ret;
+	void *preload = NULL;
 	ElfType elftype = ELFERROR;
-	int consumed = parse_args(j, argc, argv, &exit_immediately, &elftype);
+	int consumed = parse_args(j, argc, argv, &exit_immediately, &lean,
+				  &elftype);
 	argc -= consumed;
 	argv += consumed;
 
@@ -602,7 +1013,7 @@ int main(int argc, char *argv[])
 		 * Target binary is statically linked so we cannot use
 		 * libminijailpreload.so.
 		 */
-		minijail_run_no_preload(j, argv[0], argv);
+		ret = minijail_run_no_preload(j, argv[0], argv);
 	} else if (elftype == ELFDYNAMIC) {
 		/*
 		 * Target binary is dynamically linked so we can
@@ -610,22 +1021,38 @@ int main(int argc, char *argv[])
 		 */
 
 		/* Check that we can dlopen() libminijailpreload.so. */
-		if (!dlopen(PRELOADPATH, RTLD_LAZY | RTLD_LOCAL)) {
+		preload = dlopen(PRELOADPATH, RTLD_LAZY | RTLD_LOCAL);
+		if (!preload) {
 			dl_mesg = dlerror();
 			fprintf(stderr, "dlopen(): %s\n", dl_mesg);
 			return 1;
 		}
-		minijail_run(j, argv[0], argv);
+		ret = minijail_run(j, argv[0], argv);
 	} else {
 		fprintf(stderr,
 			"Target program '%s' is not a valid ELF file.\n",
 			argv[0]);
 		return 1;
 	}
+	if (ret < 0) {
+		fprintf(stderr, "Failed to run '%s': %s\n", argv[0],
+			strerror(-ret));
+		return 1;
+	}
 
 	if (exit_immediately) {
 		info("not running init loop, exiting immediately");
+		flush_log_ring();
 		return 0;
 	}
-	return minijail_wait(j);
+
+	if (lean) {
+		/* Only forward signals and reap from here on. */
+		if (preload)
+			dlclose(preload);
+		minijail_trim(j);
+	}
+	ret = minijail_wait(j);
+	flush_log_ring();
+	return ret;
 }
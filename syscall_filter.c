@@ -3,6 +3,7 @@
  * found in the LICENSE file.
  */
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,6 +17,11 @@
 
 #define ONE_INSTR	1
 #define TWO_INSTRS	2
+#define THREE_INSTRS	3
+
+/* Syscall numbers the allow-list fast path can keep in its bitmap. */
+#define ALLOW_LIST_BITS	1024
+#define BITS_PER_LONG	(8 * sizeof(unsigned long))
 /* clang-format on */
 
 int seccomp_can_softfail(void)
@@ -92,12 +98,16 @@ void append_filter_block(struct filter_block *head, struct sock_filter *instrs,
 void extend_filter_block_list(struct filter_block *list,
 			      struct filter_block *another)
 {
+	/* A single block is its own last block. */
+	struct filter_block *another_last =
+	    another->last != NULL ? another->last : another;
+
 	if (list->last != NULL) {
 		list->last->next = another;
-		list->last = another->last;
+		list->last = another_last;
 	} else {
 		list->next = another;
-		list->last = another->last;
+		list->last = another_last;
 	}
 	list->total_len += another->total_len;
 }
@@ -123,6 +133,13 @@ void append_ret_errno(struct filter_block *head, int errno_val)
 	append_filter_block(head, filter, ONE_INSTR);
 }
 
+void append_ret(struct filter_block *head, uint32_t ret)
+{
+	struct sock_filter *filter = new_instr_buf(ONE_INSTR);
+	set_bpf_stmt(filter, BPF_RET + BPF_K, ret);
+	append_filter_block(head, filter, ONE_INSTR);
+}
+
 void append_allow_syscall(struct filter_block *head, int nr)
 {
 	struct sock_filter *filter = new_instr_buf(ALLOW_SYSCALL_LEN);
@@ -480,9 +497,42 @@ int parse_include_statement(char *policy_line, unsigned int include_level,
 	return 0;
 }
 
+/*
+ * parse_default_statement: Parses "@default <action>", where <action> is
+ * "allow", or "return [errno]" like at the end of a policy line, into the
+ * seccomp return value for syscalls the policy doesn't list.
+ */
+int parse_default_statement(char *policy_line, int use_ret_trap,
+			    uint32_t *default_ret)
+{
+	char *action = policy_line + strlen("@default");
+
+	if (*action != ' ') {
+		warn("invalid default statement '%s'", policy_line);
+		return -1;
+	}
+	action = strip(action);
+
+	if (strcmp(action, "allow") == 0) {
+		*default_ret = SECCOMP_RET_ALLOW;
+		return 0;
+	}
+
+	/* Reuse compile_errno() to parse the errno, then take it back out. */
+	struct filter_block *block = new_filter_block();
+	if (compile_errno(block, action, use_ret_trap) < 0) {
+		warn("invalid default action '%s'", action);
+		free_block_list(block);
+		return -1;
+	}
+	*default_ret = block->instrs[0].k;
+	free_block_list(block);
+	return 0;
+}
+
 int compile_file(FILE *policy_file, struct filter_block *head,
 		 struct filter_block **arg_blocks, struct bpf_labels *labels,
-		 int use_ret_trap, int allow_logging,
+		 int use_ret_trap, int allow_logging, uint32_t *default_ret,
 		 unsigned int include_level)
 {
 	/*
@@ -507,6 +557,23 @@ int compile_file(FILE *policy_file, struct filter_block *head,
 			continue;
 		}
 
+		/*
+		 * Only the initial policy file gets to pick the action for
+		 * syscalls it doesn't list.
+		 */
+		if (strncmp(policy_line, "@default", strlen("@default")) == 0) {
+			if (!default_ret || parse_default_statement(
+						policy_line, use_ret_trap,
+						default_ret) != 0) {
+				warn("compile_file: failed to parse default "
+				     "statement");
+				ret = -1;
+				goto free_line;
+			}
+			default_ret = NULL; /* Only one per policy. */
+			continue;
+		}
+
 		/* Allow @include statements. */
 		if (*policy_line == '@') {
 			const char *filename = NULL;
@@ -527,7 +594,7 @@ int compile_file(FILE *policy_file, struct filter_block *head,
 			}
 			if (compile_file(included_file, head, arg_blocks,
 					 labels, use_ret_trap, allow_logging,
-					 ++include_level) == -1) {
+					 NULL, ++include_level) == -1) {
 				warn("compile_file: '@include %s' failed",
 				     filename);
 				fclose(included_file);
@@ -618,6 +685,362 @@ free_line:
 	return ret;
 }
 
+/* Syscalls |nr| through |last| all take |action|. */
+struct dispatch_entry {
+	int nr;
+	int last;
+	struct sock_filter action;
+	/* Line of the policy this came from, to order duplicates. */
+	size_t index;
+};
+
+static int compare_dispatch_entries(const void *a, const void *b)
+{
+	const struct dispatch_entry *x = a, *y = b;
+
+	if (x->nr != y->nr)
+		return x->nr < y->nr ? -1 : 1;
+	/*
+	 * qsort(3) isn't stable, so keep policy order among duplicates
+	 * explicitly: the first line wins.
+	 */
+	if (x->index != y->index)
+		return x->index < y->index ? -1 : 1;
+	return 0;
+}
+
+/* Binary search down to this many syscalls, then compare one by one. */
+#define DISPATCH_LEAF_SIZE 4
+
+/*
+ * build_dispatch_tree: Lays out the syscall number comparisons for the sorted
+ * |entries| as a binary search tree, falling through to |default_ret|.
+ */
+static struct filter_block *
+build_dispatch_tree(const struct dispatch_entry *entries, size_t count,
+		    uint32_t default_ret)
+{
+	struct filter_block *head = new_filter_block();
+
+	if (count <= DISPATCH_LEAF_SIZE) {
+		size_t i;
+		for (i = 0; i < count; i++) {
+			struct sock_filter *comp;
+			if (entries[i].nr == entries[i].last) {
+				comp = new_instr_buf(ALLOW_SYSCALL_LEN);
+				set_bpf_jump(comp, BPF_JMP + BPF_JEQ + BPF_K,
+					     entries[i].nr, NEXT, SKIP);
+				comp[1] = entries[i].action;
+				append_filter_block(head, comp,
+						    ALLOW_SYSCALL_LEN);
+				continue;
+			}
+			comp = new_instr_buf(THREE_INSTRS);
+			set_bpf_jump(comp, BPF_JMP + BPF_JGE + BPF_K,
+				     entries[i].last + 1, SKIPN(2), NEXT);
+			set_bpf_jump(comp + 1, BPF_JMP + BPF_JGE + BPF_K,
+				     entries[i].nr, NEXT, SKIP);
+			comp[2] = entries[i].action;
+			append_filter_block(head, comp, THREE_INSTRS);
+		}
+		append_ret(head, default_ret);
+		return head;
+	}
+
+	size_t mid = count / 2;
+	struct filter_block *left =
+	    build_dispatch_tree(entries, mid, default_ret);
+	struct filter_block *right =
+	    build_dispatch_tree(entries + mid, count - mid, default_ret);
+
+	/*
+	 * Syscalls at or above the middle one jump over the lower half. BPF_JA
+	 * takes a 32-bit offset, which a conditional jump's 8 bits can't hold
+	 * for large policies.
+	 */
+	struct sock_filter *split = new_instr_buf(TWO_INSTRS);
+	set_bpf_jump(split, BPF_JMP + BPF_JGE + BPF_K, entries[mid].nr, NEXT,
+		     SKIP);
+	set_bpf_stmt(split + 1, BPF_JMP + BPF_JA, left->total_len);
+	append_filter_block(head, split, TWO_INSTRS);
+	extend_filter_block_list(head, left);
+	extend_filter_block_list(head, right);
+	return head;
+}
+
+/*
+ * append_dispatch_tree: Appends the syscall number comparisons in |dispatch|,
+ * one ALLOW_SYSCALL_LEN block per policy line, to |head| as a binary search
+ * tree. Consumes |dispatch|.
+ */
+static int append_dispatch_tree(struct filter_block *head,
+				struct filter_block *dispatch,
+				uint32_t default_ret)
+{
+	struct dispatch_entry *entries;
+	struct filter_block *curr;
+	size_t count = 0, unique = 0;
+	size_t i;
+
+	for (curr = dispatch; curr; curr = curr->next) {
+		if (curr->instrs)
+			count++;
+	}
+	if (count == 0) {
+		free_block_list(dispatch);
+		append_ret(head, default_ret);
+		return 0;
+	}
+
+	entries = calloc(count, sizeof(*entries));
+	if (!entries) {
+		free_block_list(dispatch);
+		return -1;
+	}
+	for (curr = dispatch, i = 0; curr; curr = curr->next) {
+		if (!curr->instrs)
+			continue;
+		entries[i].nr = curr->instrs[0].k;
+		entries[i].last = entries[i].nr;
+		entries[i].action = curr->instrs[1];
+		entries[i].index = i;
+		i++;
+	}
+	free_block_list(dispatch);
+
+	qsort(entries, count, sizeof(*entries), compare_dispatch_entries);
+	for (i = 0; i < count; i++) {
+		struct dispatch_entry *prev =
+		    unique > 0 ? &entries[unique - 1] : NULL;
+		if (prev && prev->last == entries[i].nr)
+			continue;
+		/* Neighbours with the same action share a range check. */
+		if (prev && prev->last + 1 == entries[i].nr &&
+		    !memcmp(&prev->action, &entries[i].action,
+			    sizeof(prev->action))) {
+			prev->last = entries[i].nr;
+			continue;
+		}
+		entries[unique++] = entries[i];
+	}
+
+	extend_filter_block_list(head,
+				 build_dispatch_tree(entries, unique, default_ret));
+	free(entries);
+	return 0;
+}
+
+/*
+ * read_policy: Reads all of |file| into a NUL-terminated buffer, storing its
+ * length in |len|. Returns NULL on failure.
+ */
+static char *read_policy(FILE *file, size_t *len)
+{
+	char *buf = NULL;
+	size_t size = 0, used = 0, n;
+
+	do {
+		if (size - used < 2) {
+			char *bigger = realloc(buf, size ? 2 * size : 4096);
+			if (!bigger) {
+				free(buf);
+				return NULL;
+			}
+			buf = bigger;
+			size = size ? 2 * size : 4096;
+		}
+		n = fread(buf + used, 1, size - used - 1, file);
+		used += n;
+	} while (n > 0);
+	if (ferror(file)) {
+		free(buf);
+		return NULL;
+	}
+	buf[used] = '\0';
+	*len = used;
+	return buf;
+}
+
+/*
+ * scan_allow_list: If every line of |policy| is blank, a comment or a plain
+ * "syscall: 1", sets the bits of those syscalls in |allowed| and returns how
+ * many there are. Returns -1 as soon as a line needs the general compiler:
+ * argument filters, @-statements, unknown syscalls or anything unusual.
+ */
+static int scan_allow_list(const char *policy, size_t len,
+			   unsigned long *allowed)
+{
+	char *p, *end, *copy;
+	char **names;
+	int *nrs = NULL;
+	size_t count = 0, i;
+	int ret = -1;
+
+	memset(allowed, 0, ALLOW_LIST_BITS / 8);
+	if (memchr(policy, '\0', len))
+		return -1;
+	copy = strdup(policy);
+	/* There are at most as many names as there are lines. */
+	names = calloc(len / 2 + 1, sizeof(*names));
+	if (!copy || !names)
+		goto out;
+
+	/* Cut the names out of a copy, in place. */
+	for (p = copy, end = copy + len; p < end;) {
+		char *name;
+
+		while (p < end && isblank(*p))
+			p++;
+		if (p < end && *p == '#') {
+			p = memchr(p, '\n', end - p);
+			p = p ? p + 1 : end;
+			continue;
+		}
+		if (p < end && *p == '\n') {
+			p++;
+			continue;
+		}
+		if (p == end)
+			break;
+
+		name = p;
+		while (p < end && (isalnum(*p) || *p == '_'))
+			p++;
+		if (p == name || p == end)
+			goto out;
+		if (isblank(*p))
+			*p++ = '\0';
+		while (p < end && isblank(*p))
+			p++;
+		if (p == end || *p != ':')
+			goto out;
+		*p++ = '\0';
+		while (p < end && isblank(*p))
+			p++;
+		if (p == end || *p++ != '1')
+			goto out;
+		while (p < end && isblank(*p))
+			p++;
+		if (p < end && *p++ != '\n')
+			goto out;
+		names[count++] = name;
+	}
+
+	nrs = calloc(count + 1, sizeof(*nrs));
+	if (!nrs || lookup_syscalls((const char *const *)names, count, nrs) !=
+			(ssize_t)count)
+		goto out;
+	ret = 0;
+	for (i = 0; i < count; i++) {
+		unsigned long bit = 1UL << (nrs[i] % BITS_PER_LONG);
+
+		if (nrs[i] >= ALLOW_LIST_BITS) {
+			ret = -1;
+			break;
+		}
+		/* Repeated lines and aliases share a number. */
+		if (!(allowed[nrs[i] / BITS_PER_LONG] & bit)) {
+			allowed[nrs[i] / BITS_PER_LONG] |= bit;
+			ret++;
+		}
+	}
+
+out:
+	free(nrs);
+	free(names);
+	free(copy);
+	return ret;
+}
+
+/*
+ * append_allow_list: Appends a binary search over the runs of set bits in
+ * |allowed| to |head|, allowing those syscalls and returning |default_ret|
+ * for the rest.
+ */
+static int append_allow_list(struct filter_block *head,
+			     const unsigned long *allowed, uint32_t default_ret)
+{
+	struct dispatch_entry *entries;
+	size_t count = 0;
+	int nr;
+
+	entries = calloc(ALLOW_LIST_BITS / 2, sizeof(*entries));
+	if (!entries)
+		return -1;
+	for (nr = 0; nr < ALLOW_LIST_BITS; nr++) {
+		if (!(allowed[nr / BITS_PER_LONG] & (1UL << (nr % BITS_PER_LONG))))
+			continue;
+		if (count > 0 && entries[count - 1].last + 1 == nr) {
+			entries[count - 1].last = nr;
+			continue;
+		}
+		entries[count].nr = nr;
+		entries[count].last = nr;
+		set_bpf_stmt(&entries[count].action, BPF_RET + BPF_K,
+			     SECCOMP_RET_ALLOW);
+		count++;
+	}
+
+	if (count == 0)
+		append_ret(head, default_ret);
+	else
+		extend_filter_block_list(
+		    head, build_dispatch_tree(entries, count, default_ret));
+	free(entries);
+	return 0;
+}
+
+/*
+ * compile_policy: Compiles the |len| bytes of |policy| with the general
+ * compiler, appending the syscall dispatch to |head| and any argument filters
+ * to |arg_blocks|.
+ */
+static int compile_policy(char *policy, size_t len, struct filter_block *head,
+			  struct filter_block **arg_blocks,
+			  struct bpf_labels *labels, int use_ret_trap,
+			  int allow_logging)
+{
+	struct filter_block *dispatch;
+	uint32_t default_ret = use_ret_trap ? SECCOMP_RET_TRAP : SECCOMP_RET_KILL;
+	FILE *policy_file;
+	int ret;
+
+	policy_file = fmemopen(policy, len, "r");
+	if (!policy_file) {
+		pwarn("compile_policy: fmemopen() failed");
+		return -1;
+	}
+	dispatch = new_filter_block();
+	ret = compile_file(policy_file, dispatch, arg_blocks, labels,
+			   use_ret_trap, allow_logging, &default_ret,
+			   0 /* include_level */);
+	fclose(policy_file);
+	if (ret != 0) {
+		warn("compile_policy: compile_file() failed");
+		free_block_list(dispatch);
+		return -1;
+	}
+
+	if (default_ret == SECCOMP_RET_KILL || default_ret == SECCOMP_RET_TRAP) {
+		/*
+		 * Allow-lists keep their syscalls in policy order, so that the
+		 * most frequent ones can go first, and fall through to KILL or
+		 * TRAP.
+		 */
+		extend_filter_block_list(head, dispatch);
+		append_ret(head, default_ret);
+		return 0;
+	}
+	/*
+	 * Deny-lists from "@default allow" or "@default return <errno>" are
+	 * short and rarely hit, so look them up in a binary tree. Syscalls they
+	 * don't list then reach the default in a few comparisons that depend on
+	 * nothing but the syscall number, which lets the kernel's seccomp
+	 * action cache skip the filter for them entirely.
+	 */
+	return append_dispatch_tree(head, dispatch, default_ret);
+}
+
 int compile_filter(FILE *initial_file, struct sock_fprog *prog,
 		   int use_ret_trap, int allow_logging)
 {
@@ -629,6 +1052,13 @@ int compile_filter(FILE *initial_file, struct sock_fprog *prog,
 		return -1;
 	}
 
+	size_t policy_len;
+	char *policy = read_policy(initial_file, &policy_len);
+	if (!policy) {
+		pwarn("compile_filter: failed to read policy");
+		return -1;
+	}
+
 	struct filter_block *head = new_filter_block();
 	struct filter_block *arg_blocks = NULL;
 
@@ -646,24 +1076,31 @@ int compile_filter(FILE *initial_file, struct sock_fprog *prog,
 	if (allow_logging)
 		allow_logging_syscalls(head);
 
-	if (compile_file(initial_file, head, &arg_blocks, &labels, use_ret_trap,
-			 allow_logging, 0 /* include_level */) != 0) {
-		warn("compile_filter: compile_file() failed");
+	/*
+	 * Most policies are nothing but "syscall: 1" lines. Those go straight
+	 * from a bitmap to a search over runs of syscall numbers, without
+	 * building a block per line. A handful of syscalls are checked just as
+	 * fast in the order the policy lists them, so those keep that order.
+	 */
+	unsigned long allowed[ALLOW_LIST_BITS / BITS_PER_LONG];
+	int allowed_count = scan_allow_list(policy, policy_len, allowed);
+	int ret;
+	if (allowed_count == 0 || allowed_count > DISPATCH_LEAF_SIZE) {
+		ret = append_allow_list(
+		    head, allowed,
+		    use_ret_trap ? SECCOMP_RET_TRAP : SECCOMP_RET_KILL);
+	} else {
+		ret = compile_policy(policy, policy_len, head, &arg_blocks,
+				     &labels, use_ret_trap, allow_logging);
+	}
+	free(policy);
+	if (ret != 0) {
 		free_block_list(head);
 		free_block_list(arg_blocks);
 		free_label_strings(&labels);
 		return -1;
 	}
 
-	/*
-	 * If none of the syscalls match, either fall through to KILL,
-	 * or return TRAP.
-	 */
-	if (!use_ret_trap)
-		append_ret_kill(head);
-	else
-		append_ret_trap(head);
-
 	/* Allocate the final buffer, now that we know its size. */
 	size_t final_filter_len =
 	    head->total_len + (arg_blocks ? arg_blocks->total_len : 0);
@@ -9,6 +9,8 @@
 #ifndef SYSCALL_FILTER_H
 #define SYSCALL_FILTER_H
 
+#include <stdint.h>
+
 #include "bpf.h"
 
 #ifdef __cplusplus
@@ -32,7 +34,7 @@ struct filter_block *compile_policy_line(int nr, const char *policy_line,
 					 int do_ret_trap);
 int compile_file(FILE *policy_file, struct filter_block *head,
 		 struct filter_block **arg_blocks, struct bpf_labels *labels,
-		 int use_ret_trap, int allow_logging,
+		 int use_ret_trap, int allow_logging, uint32_t *default_ret,
 		 unsigned int include_level);
 int compile_filter(FILE *policy_file, struct sock_fprog *prog, int do_ret_trap,
 		   int add_logging_syscalls);
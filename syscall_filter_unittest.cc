@@ -957,7 +957,8 @@ TEST_F(FileTest, seccomp_mode1) {
   FILE *policy_file = write_policy_to_pipe(policy, strlen(policy));
   ASSERT_NE(policy_file, nullptr);
   int res = compile_file(
-      policy_file, head_, &arg_blocks_, &labels_, USE_RET_KILL, NO_LOGGING, 0);
+      policy_file, head_, &arg_blocks_, &labels_, USE_RET_KILL, NO_LOGGING,
+      NULL, 0);
   fclose(policy_file);
 
   /*
@@ -992,7 +993,8 @@ TEST_F(FileTest, seccomp_read) {
     FILE *policy_file = write_policy_to_pipe(policy, strlen(policy));
   ASSERT_NE(policy_file, nullptr);
   int res = compile_file(
-      policy_file, head_, &arg_blocks_, &labels_, USE_RET_KILL, NO_LOGGING, 0);
+      policy_file, head_, &arg_blocks_, &labels_, USE_RET_KILL, NO_LOGGING,
+      NULL, 0);
   fclose(policy_file);
 
   /*
@@ -1241,6 +1243,177 @@ TEST(FilterTest, nonexistent) {
   ASSERT_NE(res, 0);
 }
 
+/*
+ * Runs |prog| for syscall |nr| on this arch. Only handles the instructions
+ * that syscall number dispatch uses, so policies can't look at arguments.
+ */
+static uint32_t run_nr_filter(const struct sock_fprog *prog, int nr) {
+  uint32_t acc = 0;
+  size_t pc = 0;
+
+  while (pc < prog->len) {
+    const struct sock_filter *insn = &prog->filter[pc++];
+    switch (insn->code) {
+      case BPF_LD + BPF_W + BPF_ABS:
+        acc = insn->k == arch_nr ? ARCH_NR : nr;
+        break;
+      case BPF_JMP + BPF_JEQ + BPF_K:
+        pc += acc == insn->k ? insn->jt : insn->jf;
+        break;
+      case BPF_JMP + BPF_JGE + BPF_K:
+        pc += acc >= insn->k ? insn->jt : insn->jf;
+        break;
+      case BPF_JMP + BPF_JA:
+        pc += insn->k;
+        break;
+      case BPF_RET + BPF_K:
+        return insn->k;
+      default:
+        ADD_FAILURE() << "unexpected BPF instruction " << insn->code;
+        return SECCOMP_RET_KILL;
+    }
+  }
+  ADD_FAILURE() << "filter fell off the end";
+  return SECCOMP_RET_KILL;
+}
+
+TEST(FilterTest, allow_list_fast_path) {
+  struct sock_fprog actual;
+  const char *policy =
+      "# Plain allow-lists skip the general compiler.\n"
+      "read: 1\n"
+      "write: 1\n"
+      "  close :1\n"
+      "rt_sigreturn: 1\n"
+      "exit: 1\n"
+      "exit_group: 1\n"
+      "\n"
+      "read: 1\n";
+
+  FILE *policy_file = write_policy_to_pipe(policy, strlen(policy));
+  ASSERT_NE(policy_file, nullptr);
+
+  int res = compile_filter(policy_file, &actual, USE_RET_KILL, NO_LOGGING);
+  fclose(policy_file);
+  ASSERT_EQ(res, 0);
+
+  EXPECT_ARCH_VALIDATION(actual.filter);
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_read));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_write));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_close));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_rt_sigreturn));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_exit));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_exit_group));
+  EXPECT_EQ(SECCOMP_RET_KILL, run_nr_filter(&actual, __NR_ptrace));
+  EXPECT_EQ(SECCOMP_RET_KILL, run_nr_filter(&actual, __NR_mount));
+  EXPECT_EQ(SECCOMP_RET_KILL, run_nr_filter(&actual, 100000));
+  EXPECT_EQ(SECCOMP_RET_KILL, run_nr_filter(&actual, -1));
+
+  free(actual.filter);
+}
+
+TEST(FilterTest, default_allow) {
+  struct sock_fprog actual;
+  const char *policy =
+      "@default allow\n"
+      "ptrace: return EPERM\n"
+      "mount: return EPERM\n"
+      "reboot: return\n"
+      "kexec_load: return EPERM\n"
+      "init_module: return EPERM\n"
+      "delete_module: return EPERM\n"
+      "swapon: return EPERM\n";
+
+  FILE *policy_file = write_policy_to_pipe(policy, strlen(policy));
+  ASSERT_NE(policy_file, nullptr);
+
+  int res = compile_filter(policy_file, &actual, USE_RET_KILL, NO_LOGGING);
+  fclose(policy_file);
+  ASSERT_EQ(res, 0);
+
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_read));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_exit));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_swapoff));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, 100000));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | EPERM, run_nr_filter(&actual, __NR_ptrace));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | EPERM, run_nr_filter(&actual, __NR_mount));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | EPERM, run_nr_filter(&actual, __NR_swapon));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | EPERM,
+            run_nr_filter(&actual, __NR_delete_module));
+  EXPECT_EQ(SECCOMP_RET_KILL, run_nr_filter(&actual, __NR_reboot));
+
+  free(actual.filter);
+}
+
+TEST(FilterTest, default_errno) {
+  struct sock_fprog actual;
+  const char *policy =
+      "read: 1\n"
+      "@default return ENOSYS\n"
+      "exit: 1\n";
+
+  FILE *policy_file = write_policy_to_pipe(policy, strlen(policy));
+  ASSERT_NE(policy_file, nullptr);
+
+  int res = compile_filter(policy_file, &actual, USE_RET_KILL, NO_LOGGING);
+  fclose(policy_file);
+  ASSERT_EQ(res, 0);
+
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_read));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_exit));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | ENOSYS, run_nr_filter(&actual, __NR_write));
+
+  free(actual.filter);
+}
+
+TEST(FilterTest, default_duplicates_first_wins) {
+  struct sock_fprog actual;
+  /* The included file allows read, write, rt_sigreturn and exit. */
+  const char *policy =
+      "@default return ENOSYS\n"
+      "mount: return EPERM\n"
+      "write: return EPERM\n"
+      "ptrace: return EPERM\n"
+      "exit: return EPERM\n"
+      "@include ./test/seccomp.policy\n"
+      "read: return EPERM\n";
+
+  FILE *policy_file = write_policy_to_pipe(policy, strlen(policy));
+  ASSERT_NE(policy_file, nullptr);
+
+  int res = compile_filter(policy_file, &actual, USE_RET_KILL, NO_LOGGING);
+  fclose(policy_file);
+  ASSERT_EQ(res, 0);
+
+  EXPECT_EQ(SECCOMP_RET_ERRNO | EPERM, run_nr_filter(&actual, __NR_write));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | EPERM, run_nr_filter(&actual, __NR_exit));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_read));
+  EXPECT_EQ(SECCOMP_RET_ALLOW, run_nr_filter(&actual, __NR_rt_sigreturn));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | EPERM, run_nr_filter(&actual, __NR_mount));
+  EXPECT_EQ(SECCOMP_RET_ERRNO | ENOSYS, run_nr_filter(&actual, __NR_open));
+
+  free(actual.filter);
+}
+
+TEST(FilterTest, invalid_default) {
+  struct sock_fprog actual;
+  const char *policies[] = {
+      "@default\n",
+      "@default deny\n",
+      "@defaultallow\n",
+      "@default allow\n@default return EPERM\n",
+  };
+
+  for (const char *policy : policies) {
+    FILE *policy_file = write_policy_to_pipe(policy, strlen(policy));
+    ASSERT_NE(policy_file, nullptr);
+    EXPECT_NE(0,
+              compile_filter(policy_file, &actual, USE_RET_KILL, NO_LOGGING))
+        << policy;
+    fclose(policy_file);
+  }
+}
+
 TEST(FilterTest, log) {
   struct sock_fprog actual;
   const char *policy =
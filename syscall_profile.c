@@ -0,0 +1,456 @@
+/* Copyright 2026 The Chromium OS Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ *
+ * Two tracepoint programs do the work in the kernel: raw_syscalls:sys_enter
+ * counts the syscall and stamps the calling thread with the current time,
+ * and raw_syscalls:sys_exit adds the elapsed time to a log2 histogram for
+ * the syscall. Each program is attached once, and runs for the tracepoint on
+ * every CPU; both bail out early for tasks outside the profiled cgroup.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/bpf.h>
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "syscall_profile.h"
+
+#include "syscall_wrapper.h"
+#include "util.h"
+
+/* Syscall numbers at or above this are not profiled. */
+#define PROFILE_MAX_SYSCALLS 1024
+#define PROFILE_BUCKETS 64
+/* Threads that can be inside a syscall at the same time. */
+#define PROFILE_MAX_THREADS 16384
+
+/* Marks jumps to the common exit path, fixed up by link_and_load(). */
+#define JUMP_OUT INT16_MIN
+
+#define INSN(c, d, s, o, i)                                                    \
+	{                                                                      \
+		.code = (c), .dst_reg = (d), .src_reg = (s), .off = (o),       \
+		.imm = (i)                                                     \
+	}
+#define MOV64_REG(d, s) INSN(BPF_ALU64 | BPF_MOV | BPF_X, d, s, 0, 0)
+#define MOV64_IMM(d, i) INSN(BPF_ALU64 | BPF_MOV | BPF_K, d, 0, 0, i)
+#define ALU64_IMM(op, d, i) INSN(BPF_ALU64 | (op) | BPF_K, d, 0, 0, i)
+#define ALU64_REG(op, d, s) INSN(BPF_ALU64 | (op) | BPF_X, d, s, 0, 0)
+#define LDX_MEM(sz, d, s, o) INSN(BPF_LDX | BPF_MEM | (sz), d, s, o, 0)
+#define STX_MEM(sz, d, s, o) INSN(BPF_STX | BPF_MEM | (sz), d, s, o, 0)
+#define STX_XADD(sz, d, s, o) INSN(BPF_STX | BPF_XADD | (sz), d, s, o, 0)
+#define JMP_IMM(op, d, i, o) INSN(BPF_JMP | (op) | BPF_K, d, 0, o, i)
+#define JMP_REG(op, d, s, o) INSN(BPF_JMP | (op) | BPF_X, d, s, o, 0)
+#define CALL(f) INSN(BPF_JMP | BPF_CALL, 0, 0, 0, f)
+#define EXIT() INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0)
+#define LD_IMM64(d, s, v)                                                      \
+	INSN(BPF_LD | BPF_DW | BPF_IMM, d, s, 0, (uint32_t)(v)),               \
+	    INSN(0, 0, 0, 0, (uint32_t)((uint64_t)(v) >> 32))
+#define LD_MAP_FD(d, fd) LD_IMM64(d, BPF_PSEUDO_MAP_FD, fd)
+/* r{d} = r10 + off, i.e. a pointer to the stack. */
+#define STACK_PTR(d, off) MOV64_REG(d, BPF_REG_10), ALU64_IMM(BPF_ADD, d, off)
+
+/* Offset of the syscall number in the raw_syscalls tracepoint records. */
+#define TP_SYSCALL_ID 8
+
+struct syscall_profile {
+	int counts_fd;
+	int hist_fd;
+	int start_fd;
+	int enter_prog;
+	int exit_prog;
+	int enter_event;
+	int exit_event;
+};
+
+static int bpf_cmd(int cmd, union bpf_attr *attr)
+{
+	int ret = sys_bpf(cmd, attr, sizeof(*attr));
+	return ret < 0 ? -errno : ret;
+}
+
+static int create_map(uint32_t type, uint32_t key_size, uint32_t value_size,
+		      uint32_t max_entries)
+{
+	union bpf_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.map_type = type;
+	attr.key_size = key_size;
+	attr.value_size = value_size;
+	attr.max_entries = max_entries;
+	return bpf_cmd(BPF_MAP_CREATE, &attr);
+}
+
+static int lookup_map(int fd, const void *key, void *value)
+{
+	union bpf_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.map_fd = fd;
+	attr.key = (uintptr_t)key;
+	attr.value = (uintptr_t)value;
+	return bpf_cmd(BPF_MAP_LOOKUP_ELEM, &attr);
+}
+
+/* The last two instructions of every program are the common exit path. */
+static int link_and_load(struct bpf_insn *insns, size_t len)
+{
+	union bpf_attr attr;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		if (insns[i].off == JUMP_OUT)
+			insns[i].off = len - 2 - i - 1;
+	}
+
+	memset(&attr, 0, sizeof(attr));
+	attr.prog_type = BPF_PROG_TYPE_TRACEPOINT;
+	attr.insns = (uintptr_t)insns;
+	attr.insn_cnt = len;
+	attr.license = (uintptr_t) "BSD";
+	return bpf_cmd(BPF_PROG_LOAD, &attr);
+}
+
+static int load_enter_prog(const struct syscall_profile *p, uint64_t cgid)
+{
+	struct bpf_insn insns[] = {
+		MOV64_REG(BPF_REG_6, BPF_REG_1),
+		CALL(BPF_FUNC_get_current_cgroup_id),
+		LD_IMM64(BPF_REG_1, 0, cgid),
+		JMP_REG(BPF_JNE, BPF_REG_0, BPF_REG_1, JUMP_OUT),
+
+		/* counts[id] += 1 */
+		LDX_MEM(BPF_DW, BPF_REG_7, BPF_REG_6, TP_SYSCALL_ID),
+		JMP_IMM(BPF_JGE, BPF_REG_7, PROFILE_MAX_SYSCALLS, JUMP_OUT),
+		STX_MEM(BPF_W, BPF_REG_10, BPF_REG_7, -4),
+		LD_MAP_FD(BPF_REG_1, p->counts_fd),
+		STACK_PTR(BPF_REG_2, -4),
+		CALL(BPF_FUNC_map_lookup_elem),
+		JMP_IMM(BPF_JEQ, BPF_REG_0, 0, JUMP_OUT),
+		MOV64_IMM(BPF_REG_1, 1),
+		STX_XADD(BPF_DW, BPF_REG_0, BPF_REG_1, 0),
+
+		/* start[pid_tgid] = now, last so it isn't part of the time. */
+		CALL(BPF_FUNC_get_current_pid_tgid),
+		STX_MEM(BPF_DW, BPF_REG_10, BPF_REG_0, -16),
+		CALL(BPF_FUNC_ktime_get_ns),
+		STX_MEM(BPF_DW, BPF_REG_10, BPF_REG_0, -24),
+		LD_MAP_FD(BPF_REG_1, p->start_fd),
+		STACK_PTR(BPF_REG_2, -16),
+		STACK_PTR(BPF_REG_3, -24),
+		MOV64_IMM(BPF_REG_4, BPF_ANY),
+		CALL(BPF_FUNC_map_update_elem),
+
+		MOV64_IMM(BPF_REG_0, 0),
+		EXIT(),
+	};
+	return link_and_load(insns, ARRAY_SIZE(insns));
+}
+
+/* r8 = log2(r9), clobbering r1 and r9. */
+#define LOG2_STEP(shift)                                                       \
+	MOV64_REG(BPF_REG_1, BPF_REG_9),                                       \
+	    ALU64_IMM(BPF_RSH, BPF_REG_1, shift),                              \
+	    JMP_IMM(BPF_JEQ, BPF_REG_1, 0, 2),                                 \
+	    MOV64_REG(BPF_REG_9, BPF_REG_1),                                   \
+	    ALU64_IMM(BPF_ADD, BPF_REG_8, shift)
+
+static int load_exit_prog(const struct syscall_profile *p, uint64_t cgid)
+{
+	struct bpf_insn insns[] = {
+		MOV64_REG(BPF_REG_6, BPF_REG_1),
+		CALL(BPF_FUNC_get_current_cgroup_id),
+		LD_IMM64(BPF_REG_1, 0, cgid),
+		JMP_REG(BPF_JNE, BPF_REG_0, BPF_REG_1, JUMP_OUT),
+		CALL(BPF_FUNC_ktime_get_ns),
+		MOV64_REG(BPF_REG_9, BPF_REG_0),
+
+		/* r9 = now - start[pid_tgid], then drop the entry. */
+		CALL(BPF_FUNC_get_current_pid_tgid),
+		STX_MEM(BPF_DW, BPF_REG_10, BPF_REG_0, -16),
+		LD_MAP_FD(BPF_REG_1, p->start_fd),
+		STACK_PTR(BPF_REG_2, -16),
+		CALL(BPF_FUNC_map_lookup_elem),
+		JMP_IMM(BPF_JEQ, BPF_REG_0, 0, JUMP_OUT),
+		LDX_MEM(BPF_DW, BPF_REG_8, BPF_REG_0, 0),
+		ALU64_REG(BPF_SUB, BPF_REG_9, BPF_REG_8),
+		LD_MAP_FD(BPF_REG_1, p->start_fd),
+		STACK_PTR(BPF_REG_2, -16),
+		CALL(BPF_FUNC_map_delete_elem),
+
+		MOV64_IMM(BPF_REG_8, 0),
+		LOG2_STEP(32),
+		LOG2_STEP(16),
+		LOG2_STEP(8),
+		LOG2_STEP(4),
+		LOG2_STEP(2),
+		LOG2_STEP(1),
+
+		/* hist[id * PROFILE_BUCKETS + log2(elapsed)] += 1 */
+		LDX_MEM(BPF_DW, BPF_REG_7, BPF_REG_6, TP_SYSCALL_ID),
+		JMP_IMM(BPF_JGE, BPF_REG_7, PROFILE_MAX_SYSCALLS, JUMP_OUT),
+		ALU64_IMM(BPF_MUL, BPF_REG_7, PROFILE_BUCKETS),
+		ALU64_REG(BPF_ADD, BPF_REG_7, BPF_REG_8),
+		STX_MEM(BPF_W, BPF_REG_10, BPF_REG_7, -4),
+		LD_MAP_FD(BPF_REG_1, p->hist_fd),
+		STACK_PTR(BPF_REG_2, -4),
+		CALL(BPF_FUNC_map_lookup_elem),
+		JMP_IMM(BPF_JEQ, BPF_REG_0, 0, JUMP_OUT),
+		MOV64_IMM(BPF_REG_1, 1),
+		STX_XADD(BPF_DW, BPF_REG_0, BPF_REG_1, 0),
+
+		MOV64_IMM(BPF_REG_0, 0),
+		EXIT(),
+	};
+	return link_and_load(insns, ARRAY_SIZE(insns));
+}
+
+static int read_tracepoint_id(const char *event)
+{
+	static const char *const tracefs[] = {
+		"/sys/kernel/tracing",
+		"/sys/kernel/debug/tracing",
+	};
+	char path[128];
+	size_t i;
+	int id;
+
+	for (i = 0; i < ARRAY_SIZE(tracefs); i++) {
+		FILE *fp;
+
+		snprintf(path, sizeof(path), "%s/events/raw_syscalls/%s/id",
+			 tracefs[i], event);
+		fp = fopen(path, "re");
+		if (!fp)
+			continue;
+		if (fscanf(fp, "%d", &id) != 1)
+			id = -1;
+		fclose(fp);
+		if (id >= 0)
+			return id;
+	}
+	return -ENOENT;
+}
+
+/* The cgroup id is the handle of its directory in cgroupfs. */
+static int read_cgroup_id(const char *path, uint64_t *id)
+{
+	struct {
+		struct file_handle handle;
+		uint64_t id;
+	} buf;
+	int mount_id;
+
+	buf.handle.handle_bytes = sizeof(buf.id);
+	if (name_to_handle_at(AT_FDCWD, path, &buf.handle, &mount_id, 0))
+		return -errno;
+	if (buf.handle.handle_bytes != sizeof(buf.id))
+		return -EINVAL;
+	memcpy(id, buf.handle.f_handle, sizeof(*id));
+	return 0;
+}
+
+/*
+ * Attaches @prog to the tracepoint @event. Tracepoint programs are shared by
+ * all perf events on the tracepoint and run on every CPU, so one event is
+ * enough; a second one with the same program would fail with EEXIST.
+ *
+ * Returns the perf event fd, or a negative errno.
+ */
+static int attach_prog(const char *event, int prog)
+{
+	struct perf_event_attr attr;
+	int id = read_tracepoint_id(event);
+	int fd;
+
+	if (id < 0)
+		return id;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_TRACEPOINT;
+	attr.config = id;
+	attr.sample_period = 1;
+	attr.wakeup_events = 1;
+	fd = sys_perf_event_open(&attr, -1, 0, -1, PERF_FLAG_FD_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+	if (ioctl(fd, PERF_EVENT_IOC_SET_BPF, prog) ||
+	    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0)) {
+		int ret = -errno;
+		close(fd);
+		return ret;
+	}
+	return fd;
+}
+
+struct syscall_profile *syscall_profile_start(const char *cgroup_path)
+{
+	struct syscall_profile *p;
+	uint64_t cgid = 0;
+	int ret;
+
+	ret = read_cgroup_id(cgroup_path, &cgid);
+	if (ret) {
+		warn("failed to get the id of cgroup '%s': %s", cgroup_path,
+		     strerror(-ret));
+		return NULL;
+	}
+
+	p = calloc(1, sizeof(*p));
+	if (!p)
+		return NULL;
+	p->counts_fd = p->hist_fd = p->start_fd = -1;
+	p->enter_prog = p->exit_prog = -1;
+	p->enter_event = p->exit_event = -1;
+
+	p->counts_fd = create_map(BPF_MAP_TYPE_ARRAY, sizeof(uint32_t),
+				  sizeof(uint64_t), PROFILE_MAX_SYSCALLS);
+	p->hist_fd =
+	    create_map(BPF_MAP_TYPE_ARRAY, sizeof(uint32_t), sizeof(uint64_t),
+		       PROFILE_MAX_SYSCALLS * PROFILE_BUCKETS);
+	p->start_fd = create_map(BPF_MAP_TYPE_LRU_HASH, sizeof(uint64_t),
+				 sizeof(uint64_t), PROFILE_MAX_THREADS);
+	if (p->counts_fd < 0 || p->hist_fd < 0 || p->start_fd < 0) {
+		ret = p->counts_fd < 0 ? p->counts_fd
+				       : (p->hist_fd < 0 ? p->hist_fd
+							 : p->start_fd);
+		warn("failed to create BPF maps: %s", strerror(-ret));
+		goto error;
+	}
+
+	p->enter_prog = load_enter_prog(p, cgid);
+	p->exit_prog = load_exit_prog(p, cgid);
+	if (p->enter_prog < 0 || p->exit_prog < 0) {
+		ret = p->enter_prog < 0 ? p->enter_prog : p->exit_prog;
+		warn("failed to load BPF programs: %s", strerror(-ret));
+		goto error;
+	}
+
+	p->enter_event = attach_prog("sys_enter", p->enter_prog);
+	if (p->enter_event >= 0)
+		p->exit_event = attach_prog("sys_exit", p->exit_prog);
+	if (p->enter_event < 0 || p->exit_event < 0) {
+		ret = p->enter_event < 0 ? p->enter_event : p->exit_event;
+		warn("failed to attach to raw_syscalls tracepoints: %s",
+		     strerror(-ret));
+		goto error;
+	}
+	return p;
+
+error:
+	syscall_profile_free(p);
+	return NULL;
+}
+
+struct profile_entry {
+	uint32_t nr;
+	uint64_t count;
+};
+
+static int compare_entries(const void *a, const void *b)
+{
+	const struct profile_entry *ea = a;
+	const struct profile_entry *eb = b;
+
+	if (ea->count != eb->count)
+		return ea->count < eb->count ? 1 : -1;
+	return ea->nr < eb->nr ? -1 : ea->nr > eb->nr;
+}
+
+static void dump_latency(const struct syscall_profile *p, int fd,
+			 const char *name, uint32_t nr)
+{
+	uint32_t bucket;
+
+	dprintf(fd, "# %s latency_ns", name);
+	for (bucket = 0; bucket < PROFILE_BUCKETS; bucket++) {
+		uint32_t key = nr * PROFILE_BUCKETS + bucket;
+		uint64_t count;
+
+		if (lookup_map(p->hist_fd, &key, &count) || !count)
+			continue;
+		dprintf(fd, " %llu:%llu",
+			bucket ? 1ULL << bucket : 0ULL,
+			(unsigned long long)count);
+	}
+	dprintf(fd, "\n");
+}
+
+int syscall_profile_dump(struct syscall_profile *p, int fd, int latency)
+{
+	struct profile_entry *entries;
+	size_t count = 0;
+	size_t i;
+	uint32_t nr;
+
+	entries = calloc(PROFILE_MAX_SYSCALLS, sizeof(*entries));
+	if (!entries)
+		return -ENOMEM;
+	for (nr = 0; nr < PROFILE_MAX_SYSCALLS; nr++) {
+		uint64_t value;
+		int ret = lookup_map(p->counts_fd, &nr, &value);
+
+		if (ret) {
+			free(entries);
+			return ret;
+		}
+		if (!value)
+			continue;
+		entries[count].nr = nr;
+		entries[count].count = value;
+		count++;
+	}
+	qsort(entries, count, sizeof(*entries), compare_entries);
+
+	for (i = 0; i < count; i++) {
+		const char *name = lookup_syscall_name(entries[i].nr);
+		char unknown[16];
+
+		/* Syscalls the table doesn't know can't go in a policy. */
+		if (!name) {
+			snprintf(unknown, sizeof(unknown), "%u",
+				 entries[i].nr);
+			name = unknown;
+		}
+		dprintf(fd, "# %s: %llu calls\n", name,
+			(unsigned long long)entries[i].count);
+		if (name != unknown)
+			dprintf(fd, "%s: 1\n", name);
+		if (latency)
+			dump_latency(p, fd, name, entries[i].nr);
+	}
+	free(entries);
+	return 0;
+}
+
+void syscall_profile_free(struct syscall_profile *p)
+{
+	if (!p)
+		return;
+	if (p->enter_event >= 0)
+		close(p->enter_event);
+	if (p->exit_event >= 0)
+		close(p->exit_event);
+	if (p->enter_prog >= 0)
+		close(p->enter_prog);
+	if (p->exit_prog >= 0)
+		close(p->exit_prog);
+	if (p->counts_fd >= 0)
+		close(p->counts_fd);
+	if (p->hist_fd >= 0)
+		close(p->hist_fd);
+	if (p->start_fd >= 0)
+		close(p->start_fd);
+	free(p);
+}
@@ -0,0 +1,42 @@
+/* syscall_profile.h
+ * Copyright 2026 The Chromium OS Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ *
+ * Per-cgroup syscall profiling with eBPF tracepoint programs.
+ */
+
+#ifndef SYSCALL_PROFILE_H
+#define SYSCALL_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct syscall_profile;
+
+/*
+ * Starts counting syscalls, and timing them, for tasks in the cgroup at
+ * @cgroup_path. Needs CAP_BPF and CAP_PERFMON (or CAP_SYS_ADMIN).
+ *
+ * Returns NULL on failure.
+ */
+struct syscall_profile *syscall_profile_start(const char *cgroup_path);
+
+/*
+ * Writes the syscalls seen to @fd as a seccomp policy of "name: 1" lines, most
+ * frequent first, each after a "# name: count calls" comment. If @latency is
+ * set, each is followed by a comment with the syscall's latency histogram as
+ * "<lower bound in ns>:<count>" log2 buckets.
+ *
+ * Returns 0 on success.
+ */
+int syscall_profile_dump(struct syscall_profile *profile, int fd, int latency);
+
+void syscall_profile_free(struct syscall_profile *profile);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* SYSCALL_PROFILE_H */
@@ -16,6 +16,7 @@
 #include "syscall_wrapper.h"
 
 #define _GNU_SOURCE
+#include <errno.h>
 #include <sys/syscall.h>
 #include <unistd.h>
 
@@ -23,3 +24,93 @@ int sys_seccomp(unsigned int operation, unsigned int flags, void *args)
 {
 	return syscall(SYS_seccomp, operation, flags, args);
 }
+
+int sys_ioprio_set(int which, int who, int ioprio)
+{
+	return syscall(SYS_ioprio_set, which, who, ioprio);
+}
+
+int sys_sched_setattr(pid_t pid, void *attr, unsigned int flags)
+{
+#ifdef SYS_sched_setattr
+	return syscall(SYS_sched_setattr, pid, attr, flags);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+int sys_set_mempolicy(int mode, const unsigned long *nodemask,
+		      unsigned long maxnode)
+{
+	return syscall(SYS_set_mempolicy, mode, nodemask, maxnode);
+}
+
+int sys_perf_event_open(void *attr, pid_t pid, int cpu, int group_fd,
+			unsigned long flags)
+{
+	return syscall(SYS_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+int sys_bpf(int cmd, void *attr, unsigned int size)
+{
+#ifdef SYS_bpf
+	return syscall(SYS_bpf, cmd, attr, size);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+int sys_pidfd_open(pid_t pid, unsigned int flags)
+{
+#ifdef SYS_pidfd_open
+	return syscall(SYS_pidfd_open, pid, flags);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+int sys_clone3(void *args, size_t size)
+{
+#ifdef SYS_clone3
+	return syscall(SYS_clone3, args, size);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+int sys_landlock_create_ruleset(const void *attr, size_t size,
+				unsigned int flags)
+{
+#ifdef SYS_landlock_create_ruleset
+	return syscall(SYS_landlock_create_ruleset, attr, size, flags);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+int sys_landlock_add_rule(int ruleset_fd, int rule_type, const void *attr,
+			  unsigned int flags)
+{
+#ifdef SYS_landlock_add_rule
+	return syscall(SYS_landlock_add_rule, ruleset_fd, rule_type, attr,
+		       flags);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+int sys_landlock_restrict_self(int ruleset_fd, unsigned int flags)
+{
+#ifdef SYS_landlock_restrict_self
+	return syscall(SYS_landlock_restrict_self, ruleset_fd, flags);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
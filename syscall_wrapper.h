@@ -14,4 +14,20 @@
  * limitations under the License.
  */
 
+#include <sys/types.h>
+
 int sys_seccomp(unsigned int operation, unsigned int flags, void *args);
+int sys_ioprio_set(int which, int who, int ioprio);
+int sys_sched_setattr(pid_t pid, void *attr, unsigned int flags);
+int sys_set_mempolicy(int mode, const unsigned long *nodemask,
+		      unsigned long maxnode);
+int sys_perf_event_open(void *attr, pid_t pid, int cpu, int group_fd,
+			unsigned long flags);
+int sys_bpf(int cmd, void *attr, unsigned int size);
+int sys_pidfd_open(pid_t pid, unsigned int flags);
+int sys_clone3(void *args, size_t size);
+int sys_landlock_create_ruleset(const void *attr, size_t size,
+				unsigned int flags);
+int sys_landlock_add_rule(int ruleset_fd, int rule_type, const void *attr,
+			  unsigned int flags);
+int sys_landlock_restrict_self(int ruleset_fd, unsigned int flags);
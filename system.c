@@ -13,20 +13,33 @@
  * limitations under the License.
  */
 
+#define _GNU_SOURCE
+
 #include "system.h"
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <linux/if_link.h>
+#include <linux/landlock.h>
+#include <linux/netlink.h>
+#include <linux/perf_event.h>
+#include <linux/rtnetlink.h>
+#include <linux/veth.h>
 #include <net/if.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/prctl.h>
+#include <sys/resource.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
+#include "syscall_wrapper.h"
 #include "util.h"
 
 #ifdef HAVE_SECUREBITS_H
@@ -108,6 +121,42 @@ int write_proc_file(pid_t pid, const char *content, const char *basename)
 	return 0;
 }
 
+/*
+ * read_proc_start_time: Reads when @pid started, in clock ticks since boot,
+ * from /proc/<pid>/stat. Together with the pid it names one process for the
+ * life of the system, unlike the pid alone.
+ */
+int read_proc_start_time(pid_t pid, uint64_t *start_time)
+{
+	char filename[32];
+	char buf[1024];
+	char *p;
+	ssize_t len;
+	int fd, field;
+
+	snprintf(filename, sizeof(filename), "/proc/%d/stat", pid);
+	fd = open(filename, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+	len = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (len <= 0)
+		return -EIO;
+	buf[len] = '\0';
+
+	/* The command name may hold anything, so start after its ')'. */
+	p = strrchr(buf, ')');
+	if (!p)
+		return -EIO;
+	/* The start time is field 22; the state after the ')' is field 3. */
+	for (field = 2; field < 22 && p; field++)
+		p = strchr(p + 1, ' ');
+	if (!p)
+		return -EIO;
+	*start_time = strtoull(p + 1, NULL, 10);
+	return 0;
+}
+
 /*
  * We specifically do not use cap_valid() as that only tells us the last
  * valid cap we were *compiled* against (i.e. what the version of kernel
@@ -146,6 +195,249 @@ int cap_ambient_supported(void)
 	       0;
 }
 
+/* sched_setattr(2) arguments, see include/uapi/linux/sched/types.h. */
+struct sched_attr_args {
+	uint32_t size;
+	uint32_t sched_policy;
+	uint64_t sched_flags;
+	int32_t sched_nice;
+	uint32_t sched_priority;
+	uint64_t sched_runtime;
+	uint64_t sched_deadline;
+	uint64_t sched_period;
+	uint32_t sched_util_min;
+	uint32_t sched_util_max;
+};
+
+#define SCHED_FLAG_KEEP_POLICY 0x08
+#define SCHED_FLAG_KEEP_PARAMS 0x10
+#define SCHED_FLAG_UTIL_CLAMP_MIN 0x20
+#define SCHED_FLAG_UTIL_CLAMP_MAX 0x40
+
+/*
+ * set_sched_attr: Switches the calling thread to the non-realtime scheduling
+ * @policy, or keeps the current policy if @policy is negative, and sets its
+ * utilization clamps if @set_uclamp is non-zero.
+ */
+int set_sched_attr(int policy, int set_uclamp, uint32_t util_min,
+		   uint32_t util_max)
+{
+	struct sched_attr_args attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	if (policy < 0) {
+		attr.sched_flags |= SCHED_FLAG_KEEP_POLICY |
+				    SCHED_FLAG_KEEP_PARAMS;
+	} else {
+		/* Changing the policy also resets the nice value; keep it. */
+		errno = 0;
+		attr.sched_nice = getpriority(PRIO_PROCESS, 0);
+		if (errno)
+			return -errno;
+		attr.sched_policy = policy;
+	}
+	if (set_uclamp) {
+		attr.sched_flags |=
+		    SCHED_FLAG_UTIL_CLAMP_MIN | SCHED_FLAG_UTIL_CLAMP_MAX;
+		attr.sched_util_min = util_min;
+		attr.sched_util_max = util_max;
+	}
+
+	if (sys_sched_setattr(0, &attr, 0))
+		return -errno;
+	return 0;
+}
+
+/* clone3(2) arguments, see include/uapi/linux/sched.h. */
+struct clone3_args {
+	uint64_t flags;
+	uint64_t pidfd;
+	uint64_t child_tid;
+	uint64_t parent_tid;
+	uint64_t exit_signal;
+	uint64_t stack;
+	uint64_t stack_size;
+	uint64_t tls;
+};
+
+/*
+ * clone_namespaces: Forks like fork(2), bypassing libc, with the child in the
+ * new CLONE_NEW* namespaces in @ns_flags. Kernels without clone3(2) get the
+ * same flags through clone(2).
+ *
+ * Returns the child's pid in the parent and 0 in the child, or -1 with errno
+ * set.
+ */
+pid_t clone_namespaces(unsigned long ns_flags)
+{
+	struct clone3_args args;
+	pid_t pid;
+
+	memset(&args, 0, sizeof(args));
+	args.flags = ns_flags;
+	args.exit_signal = SIGCHLD;
+	pid = sys_clone3(&args, sizeof(args));
+	if (pid < 0 && errno == ENOSYS)
+		pid = syscall(SYS_clone, ns_flags | SIGCHLD, NULL);
+	return pid;
+}
+
+/*
+ * open_perf_counter: Opens a counting perf event of @type and @config.
+ * With @cgroup_fd >= 0 the counter is per-@cpu and restricted to the cgroup;
+ * otherwise it follows @pid and every task it creates afterwards.
+ * Kernel-side counting is dropped if perf_event_paranoid doesn't allow it.
+ *
+ * Returns the perf event fd, or a negative errno.
+ */
+int open_perf_counter(uint32_t type, uint64_t config, pid_t pid, int cpu,
+		      int cgroup_fd)
+{
+	struct perf_event_attr attr;
+	int fd;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+			   PERF_FORMAT_TOTAL_TIME_RUNNING;
+	attr.exclude_hv = 1;
+	if (cgroup_fd < 0)
+		attr.inherit = 1;
+
+	for (;;) {
+		if (cgroup_fd >= 0)
+			fd = sys_perf_event_open(&attr, cgroup_fd, cpu, -1,
+						 PERF_FLAG_PID_CGROUP |
+						     PERF_FLAG_FD_CLOEXEC);
+		else
+			fd = sys_perf_event_open(&attr, pid, -1, -1,
+						 PERF_FLAG_FD_CLOEXEC);
+		if (fd >= 0)
+			return fd;
+		if ((errno != EACCES && errno != EPERM) || attr.exclude_kernel)
+			return -errno;
+		attr.exclude_kernel = 1;
+	}
+}
+
+/*
+ * read_perf_counter: Reads the value of the counter @fd into @value, scaled up
+ * for the time it was not scheduled on the PMU because of multiplexing.
+ */
+int read_perf_counter(int fd, uint64_t *value)
+{
+	/* value, time enabled, time running */
+	uint64_t buf[3];
+	ssize_t bytes = read(fd, buf, sizeof(buf));
+
+	if (bytes < 0)
+		return -errno;
+	if (bytes != sizeof(buf))
+		return -EIO;
+	if (buf[2] == 0)
+		*value = 0;
+	else if (buf[2] < buf[1])
+		*value = (uint64_t)((double)buf[0] * buf[1] / buf[2]);
+	else
+		*value = buf[0];
+	return 0;
+}
+
+#ifndef LANDLOCK_ACCESS_FS_REFER
+#define LANDLOCK_ACCESS_FS_REFER (1ULL << 13)
+#endif
+#ifndef LANDLOCK_ACCESS_FS_TRUNCATE
+#define LANDLOCK_ACCESS_FS_TRUNCATE (1ULL << 14)
+#endif
+
+#define LANDLOCK_READ_ACCESS                                                   \
+	(LANDLOCK_ACCESS_FS_READ_FILE | LANDLOCK_ACCESS_FS_READ_DIR)
+#define LANDLOCK_WRITE_ACCESS                                                  \
+	(LANDLOCK_ACCESS_FS_WRITE_FILE | LANDLOCK_ACCESS_FS_REMOVE_DIR |        \
+	 LANDLOCK_ACCESS_FS_REMOVE_FILE | LANDLOCK_ACCESS_FS_MAKE_CHAR |       \
+	 LANDLOCK_ACCESS_FS_MAKE_DIR | LANDLOCK_ACCESS_FS_MAKE_REG |           \
+	 LANDLOCK_ACCESS_FS_MAKE_SOCK | LANDLOCK_ACCESS_FS_MAKE_FIFO |         \
+	 LANDLOCK_ACCESS_FS_MAKE_BLOCK | LANDLOCK_ACCESS_FS_MAKE_SYM |         \
+	 LANDLOCK_ACCESS_FS_REFER | LANDLOCK_ACCESS_FS_TRUNCATE)
+/* The only rights that make sense on a file rather than a directory. */
+#define LANDLOCK_FILE_ACCESS                                                   \
+	(LANDLOCK_ACCESS_FS_EXECUTE | LANDLOCK_ACCESS_FS_WRITE_FILE |          \
+	 LANDLOCK_ACCESS_FS_READ_FILE | LANDLOCK_ACCESS_FS_TRUNCATE)
+
+/* Rights the running kernel's Landlock ABI knows how to handle. */
+static uint64_t landlock_handled_access(void)
+{
+	int abi = sys_landlock_create_ruleset(NULL, 0,
+					      LANDLOCK_CREATE_RULESET_VERSION);
+	uint64_t access = LANDLOCK_ACCESS_FS_EXECUTE | LANDLOCK_READ_ACCESS |
+			  LANDLOCK_WRITE_ACCESS;
+
+	if (abi < 2)
+		access &= ~LANDLOCK_ACCESS_FS_REFER;
+	if (abi < 3)
+		access &= ~LANDLOCK_ACCESS_FS_TRUNCATE;
+	return access;
+}
+
+/*
+ * open_landlock_ruleset: Creates a Landlock ruleset that denies all
+ * filesystem access not later allowed with landlock_allow_path().
+ *
+ * Returns the ruleset fd, or -EOPNOTSUPP if the kernel lacks Landlock.
+ */
+int open_landlock_ruleset(void)
+{
+	struct landlock_ruleset_attr attr = {
+		.handled_access_fs = landlock_handled_access(),
+	};
+	int fd = sys_landlock_create_ruleset(&attr, sizeof(attr), 0);
+
+	/* Ruleset fds are always close-on-exec. */
+	if (fd < 0)
+		return errno == ENOSYS ? -EOPNOTSUPP : -errno;
+	return fd;
+}
+
+/*
+ * landlock_allow_path: Allows the LANDLOCK_FS_* rights in @access beneath
+ * @path, resolved now, in the ruleset @ruleset_fd.
+ */
+int landlock_allow_path(int ruleset_fd, const char *path, int access)
+{
+	struct landlock_path_beneath_attr attr = {
+		.allowed_access = 0,
+	};
+	struct stat st;
+	int ret = 0;
+
+	if (access & LANDLOCK_FS_READ)
+		attr.allowed_access |= LANDLOCK_READ_ACCESS;
+	if (access & LANDLOCK_FS_WRITE)
+		attr.allowed_access |= LANDLOCK_WRITE_ACCESS;
+	if (access & LANDLOCK_FS_EXEC)
+		attr.allowed_access |= LANDLOCK_ACCESS_FS_EXECUTE;
+	attr.allowed_access &= landlock_handled_access();
+
+	attr.parent_fd = open(path, O_PATH | O_CLOEXEC);
+	if (attr.parent_fd < 0)
+		return -errno;
+	if (fstat(attr.parent_fd, &st)) {
+		ret = -errno;
+		goto out;
+	}
+	if (!S_ISDIR(st.st_mode))
+		attr.allowed_access &= LANDLOCK_FILE_ACCESS;
+	if (sys_landlock_add_rule(ruleset_fd, LANDLOCK_RULE_PATH_BENEATH, &attr,
+				  0))
+		ret = -errno;
+out:
+	close(attr.parent_fd);
+	return ret;
+}
+
 int config_net_loopback(void)
 {
 	const char ifname[] = "lo";
@@ -182,6 +474,237 @@ int config_net_loopback(void)
 	return 0;
 }
 
+/*
+ * A batch of rtnetlink requests, sent with a single sendmsg(2). Attributes are
+ * always appended to the last message in the batch.
+ */
+struct nl_batch {
+	char buf[1024] __attribute__((aligned(NLMSG_ALIGNTO)));
+	size_t len;
+	unsigned int count;
+	int error;
+};
+
+static struct nlmsghdr *nl_msg(struct nl_batch *b, uint16_t type,
+			       uint16_t flags, const void *payload,
+			       size_t payload_len)
+{
+	struct nlmsghdr *msg = (struct nlmsghdr *)(b->buf + b->len);
+	size_t len = NLMSG_LENGTH(payload_len);
+
+	if (b->len + NLMSG_ALIGN(len) > sizeof(b->buf)) {
+		b->error = -ENOBUFS;
+		return msg;
+	}
+	memset(msg, 0, NLMSG_ALIGN(len));
+	msg->nlmsg_len = len;
+	msg->nlmsg_type = type;
+	msg->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | flags;
+	msg->nlmsg_seq = ++b->count;
+	memcpy(NLMSG_DATA(msg), payload, payload_len);
+	b->len += NLMSG_ALIGN(len);
+	return msg;
+}
+
+static struct rtattr *nl_attr(struct nl_batch *b, struct nlmsghdr *msg,
+			      uint16_t type, const void *data, size_t data_len)
+{
+	struct rtattr *rta = (struct rtattr *)(b->buf + b->len);
+	size_t len = RTA_LENGTH(data_len);
+
+	if (b->error || b->len + RTA_ALIGN(len) > sizeof(b->buf)) {
+		b->error = -ENOBUFS;
+		return rta;
+	}
+	memset(rta, 0, RTA_ALIGN(len));
+	rta->rta_type = type;
+	rta->rta_len = len;
+	if (data_len)
+		memcpy(RTA_DATA(rta), data, data_len);
+	b->len += RTA_ALIGN(len);
+	msg->nlmsg_len = NLMSG_ALIGN(msg->nlmsg_len) + RTA_ALIGN(len);
+	return rta;
+}
+
+static void nl_attr_str(struct nl_batch *b, struct nlmsghdr *msg,
+			uint16_t type, const char *str)
+{
+	nl_attr(b, msg, type, str, strlen(str) + 1);
+}
+
+/* Nested attributes: everything added after nl_nest() until nl_nest_end(). */
+static struct rtattr *nl_nest(struct nl_batch *b, struct nlmsghdr *msg,
+			      uint16_t type)
+{
+	return nl_attr(b, msg, type, NULL, 0);
+}
+
+static void nl_nest_end(struct nl_batch *b, struct rtattr *nest)
+{
+	if (!b->error)
+		nest->rta_len = b->buf + b->len - (char *)nest;
+}
+
+/*
+ * nl_send_batch: Sends every request in @b and collects their acks.
+ *
+ * Returns 0 if all of them succeeded, or the first error.
+ */
+static int nl_send_batch(int sock, struct nl_batch *b)
+{
+	char buf[4096] __attribute__((aligned(NLMSG_ALIGNTO)));
+	struct sockaddr_nl kernel = {
+		.nl_family = AF_NETLINK,
+	};
+	unsigned int acked = 0;
+	int ret = 0;
+
+	if (b->error)
+		return b->error;
+	if (sendto(sock, b->buf, b->len, 0, (struct sockaddr *)&kernel,
+		   sizeof(kernel)) < 0)
+		return -errno;
+
+	while (acked < b->count) {
+		struct nlmsghdr *msg;
+		ssize_t len = recv(sock, buf, sizeof(buf), 0);
+		if (len < 0)
+			return -errno;
+
+		for (msg = (struct nlmsghdr *)buf; NLMSG_OK(msg, (size_t)len);
+		     msg = NLMSG_NEXT(msg, len)) {
+			const struct nlmsgerr *err = NLMSG_DATA(msg);
+
+			if (msg->nlmsg_type != NLMSG_ERROR)
+				continue;
+			acked++;
+			if (err->error && !ret)
+				ret = err->error;
+		}
+	}
+	return ret;
+}
+
+/* Like if_nametoindex(3), but in the network namespace of @sock. */
+static int nl_ifindex(int sock, const char *ifname)
+{
+	struct ifreq ifr;
+
+	memset(&ifr, 0, sizeof(ifr));
+	strncpy(ifr.ifr_name, ifname, IFNAMSIZ - 1);
+	if (ioctl(sock, SIOCGIFINDEX, &ifr))
+		return -errno;
+	return ifr.ifr_ifindex;
+}
+
+static void nl_add_ipv4(struct nl_batch *b, int ifindex,
+			const struct in_addr *addr, int prefixlen)
+{
+	struct ifaddrmsg ifa = {
+		.ifa_family = AF_INET,
+		.ifa_prefixlen = prefixlen,
+		.ifa_scope = RT_SCOPE_UNIVERSE,
+		.ifa_index = ifindex,
+	};
+	struct nlmsghdr *msg = nl_msg(b, RTM_NEWADDR, NLM_F_CREATE | NLM_F_EXCL,
+				      &ifa, sizeof(ifa));
+	nl_attr(b, msg, IFA_LOCAL, addr, sizeof(*addr));
+	nl_attr(b, msg, IFA_ADDRESS, addr, sizeof(*addr));
+}
+
+/*
+ * config_net_veth: Creates a veth pair with one end in the host network
+ * namespace of @host_sock and the other in the namespace of @jail_sock,
+ * addresses both ends, points the jail's default route at the host end and
+ * brings every link, including the jail's loopback, up.
+ * Both sockets must be NETLINK_ROUTE sockets.
+ *
+ * Returns 0 on success, or a negative errno.
+ */
+int config_net_veth(int host_sock, int jail_sock,
+		    const struct veth_config *cfg)
+{
+	struct ifinfomsg link = {
+		.ifi_family = AF_UNSPEC,
+	};
+	struct ifinfomsg up = {
+		.ifi_family = AF_UNSPEC,
+		.ifi_flags = IFF_UP,
+		.ifi_change = IFF_UP,
+	};
+	struct nl_batch b;
+	struct nlmsghdr *msg;
+	struct rtattr *linkinfo, *data, *peer;
+	int ifindex;
+	int ret;
+
+	/*
+	 * The pair, with the peer created straight in the jail's namespace.
+	 * Neither end can come up before both exist.
+	 */
+	memset(&b, 0, sizeof(b));
+	msg = nl_msg(&b, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, &link,
+		     sizeof(link));
+	nl_attr_str(&b, msg, IFLA_IFNAME, cfg->host_ifname);
+	linkinfo = nl_nest(&b, msg, IFLA_LINKINFO);
+	nl_attr_str(&b, msg, IFLA_INFO_KIND, "veth");
+	data = nl_nest(&b, msg, IFLA_INFO_DATA);
+	peer = nl_attr(&b, msg, VETH_INFO_PEER, &link, sizeof(link));
+	nl_attr_str(&b, msg, IFLA_IFNAME, cfg->jail_ifname);
+	nl_attr(&b, msg, IFLA_NET_NS_FD, &cfg->netns_fd,
+		sizeof(cfg->netns_fd));
+	nl_nest_end(&b, peer);
+	nl_nest_end(&b, data);
+	nl_nest_end(&b, linkinfo);
+	ret = nl_send_batch(host_sock, &b);
+	if (ret)
+		return ret;
+
+	/* Host side: address and link up. */
+	memset(&b, 0, sizeof(b));
+	ifindex = nl_ifindex(host_sock, cfg->host_ifname);
+	if (ifindex < 0)
+		return ifindex;
+	if (cfg->has_addrs)
+		nl_add_ipv4(&b, ifindex, &cfg->host_addr, cfg->prefixlen);
+	up.ifi_index = ifindex;
+	nl_msg(&b, RTM_NEWLINK, 0, &up, sizeof(up));
+	ret = nl_send_batch(host_sock, &b);
+	if (ret)
+		return ret;
+
+	/* Jail side: loopback and link up, address and default route. */
+	memset(&b, 0, sizeof(b));
+	ifindex = nl_ifindex(jail_sock, "lo");
+	if (ifindex < 0)
+		return ifindex;
+	up.ifi_index = ifindex;
+	nl_msg(&b, RTM_NEWLINK, 0, &up, sizeof(up));
+	ifindex = nl_ifindex(jail_sock, cfg->jail_ifname);
+	if (ifindex < 0)
+		return ifindex;
+	if (cfg->has_addrs)
+		nl_add_ipv4(&b, ifindex, &cfg->jail_addr, cfg->prefixlen);
+	up.ifi_index = ifindex;
+	nl_msg(&b, RTM_NEWLINK, 0, &up, sizeof(up));
+	if (cfg->has_addrs) {
+		struct rtmsg rtm = {
+			.rtm_family = AF_INET,
+			.rtm_table = RT_TABLE_MAIN,
+			.rtm_protocol = RTPROT_BOOT,
+			.rtm_scope = RT_SCOPE_UNIVERSE,
+			.rtm_type = RTN_UNICAST,
+		};
+
+		msg = nl_msg(&b, RTM_NEWROUTE, NLM_F_CREATE | NLM_F_EXCL, &rtm,
+			     sizeof(rtm));
+		nl_attr(&b, msg, RTA_GATEWAY, &cfg->host_addr,
+			sizeof(cfg->host_addr));
+		nl_attr(&b, msg, RTA_OIF, &ifindex, sizeof(ifindex));
+	}
+	return nl_send_batch(jail_sock, &b);
+}
+
 int setup_pipe_end(int fds[2], size_t index)
 {
 	if (index > 1)
@@ -191,6 +714,38 @@ int setup_pipe_end(int fds[2], size_t index)
 	return fds[index];
 }
 
+/*
+ * pipe_above_stdio: Like pipe(2), but keeps both ends above stderr, so that
+ * a child setting up its stdio with setup_and_dupe_pipe_end() can't clobber
+ * them when the parent runs with stdio closed.
+ *
+ * Returns 0 on success, or -1 with errno set.
+ */
+int pipe_above_stdio(int fds[2])
+{
+	size_t i;
+
+	if (pipe(fds))
+		return -1;
+	for (i = 0; i < 2; i++) {
+		int fd;
+
+		if (fds[i] > STDERR_FILENO)
+			continue;
+		fd = fcntl(fds[i], F_DUPFD, STDERR_FILENO + 1);
+		if (fd < 0) {
+			int saved_errno = errno;
+			close(fds[0]);
+			close(fds[1]);
+			errno = saved_errno;
+			return -1;
+		}
+		close(fds[i]);
+		fds[i] = fd;
+	}
+	return 0;
+}
+
 int setup_and_dupe_pipe_end(int fds[2], size_t index, int fd)
 {
 	if (index > 1)
@@ -201,6 +756,101 @@ int setup_and_dupe_pipe_end(int fds[2], size_t index, int fd)
 	return dup2(fds[index], fd);
 }
 
+int write_cgroup_file(const char *cgroup_dir, const char *name,
+		      const char *content)
+{
+	int fd;
+	size_t len;
+	ssize_t written;
+	char path[PATH_MAX];
+	int ret;
+
+	ret = snprintf(path, sizeof(path), "%s/%s", cgroup_dir, name);
+	if (ret < 0 || (size_t)ret >= sizeof(path)) {
+		warn("failed to generate cgroup file name for '%s'", name);
+		return -ENAMETOOLONG;
+	}
+
+	fd = open(path, O_WRONLY | O_CLOEXEC);
+	if (fd < 0) {
+		pwarn("failed to open '%s'", path);
+		return -errno;
+	}
+
+	len = strlen(content);
+	written = write(fd, content, len);
+	if (written < 0) {
+		ret = -errno;
+		pwarn("failed to write '%s' to '%s'", content, path);
+		close(fd);
+		return ret;
+	}
+	close(fd);
+
+	if ((size_t)written < len) {
+		warn("failed to write %zu bytes to '%s'", len, path);
+		return -EIO;
+	}
+	return 0;
+}
+
+int read_cgroup_file(const char *cgroup_dir, const char *name, char *buf,
+		     size_t size)
+{
+	int fd;
+	ssize_t bytes;
+	char path[PATH_MAX];
+	int ret;
+
+	if (size == 0)
+		return -EINVAL;
+	ret = snprintf(path, sizeof(path), "%s/%s", cgroup_dir, name);
+	if (ret < 0 || (size_t)ret >= sizeof(path))
+		return -ENAMETOOLONG;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+	bytes = read(fd, buf, size - 1);
+	ret = bytes < 0 ? -errno : 0;
+	close(fd);
+	if (ret)
+		return ret;
+	buf[bytes] = '\0';
+	return 0;
+}
+
+/*
+ * open_psi_trigger: Registers a PSI trigger on a cgroup pressure file.
+ * The trigger stays active as long as the returned fd is open, and the fd
+ * polls with POLLPRI each time the trigger fires.
+ */
+int open_psi_trigger(const char *cgroup_dir, const char *name,
+		     const char *trigger)
+{
+	int fd, ret;
+	char path[PATH_MAX];
+
+	ret = snprintf(path, sizeof(path), "%s/%s", cgroup_dir, name);
+	if (ret < 0 || (size_t)ret >= sizeof(path))
+		return -ENAMETOOLONG;
+
+	fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0) {
+		pwarn("failed to open '%s'", path);
+		return -errno;
+	}
+	/* The trigger must be written, NUL included, in a single write(2). */
+	if (write(fd, trigger, strlen(trigger) + 1) < 0) {
+		ret = -errno;
+		pwarn("failed to register PSI trigger '%s' on '%s'", trigger,
+		      path);
+		close(fd);
+		return ret;
+	}
+	return fd;
+}
+
 int write_pid_to_path(pid_t pid, const char *path)
 {
 	FILE *fp = fopen(path, "w");
@@ -19,6 +19,7 @@
 #ifndef _SYSTEM_H_
 #define _SYSTEM_H_
 
+#include <netinet/in.h>
 #include <sys/capability.h>
 #include <sys/prctl.h>
 #include <sys/types.h>
@@ -53,13 +54,56 @@ int lock_securebits(uint64_t skip_mask);
 unsigned int get_last_valid_cap(void);
 int cap_ambient_supported(void);
 
+int set_sched_attr(int policy, int set_uclamp, uint32_t util_min,
+		   uint32_t util_max);
+
+pid_t clone_namespaces(unsigned long ns_flags);
+
+int open_perf_counter(uint32_t type, uint64_t config, pid_t pid, int cpu,
+		      int cgroup_fd);
+int read_perf_counter(int fd, uint64_t *value);
+
+/*
+ * Filesystem rights for open_landlock_ruleset() and landlock_allow_path().
+ * Read covers listing directories; write covers everything that changes a
+ * tree, including creating and removing files in it.
+ */
+#define LANDLOCK_FS_READ (1 << 0)
+#define LANDLOCK_FS_WRITE (1 << 1)
+#define LANDLOCK_FS_EXEC (1 << 2)
+
+int open_landlock_ruleset(void);
+int landlock_allow_path(int ruleset_fd, const char *path, int access);
+
 int config_net_loopback(void);
 
+struct veth_config {
+	const char *host_ifname;
+	const char *jail_ifname;
+	/* The jail's network namespace. */
+	int netns_fd;
+	int has_addrs;
+	struct in_addr host_addr;
+	struct in_addr jail_addr;
+	int prefixlen;
+};
+
+int config_net_veth(int host_sock, int jail_sock,
+		    const struct veth_config *cfg);
+
+int pipe_above_stdio(int fds[2]);
 int setup_pipe_end(int fds[2], size_t index);
 int setup_and_dupe_pipe_end(int fds[2], size_t index, int fd);
 
 int write_pid_to_path(pid_t pid, const char *path);
+int write_cgroup_file(const char *cgroup_dir, const char *name,
+		      const char *content);
+int read_cgroup_file(const char *cgroup_dir, const char *name, char *buf,
+		     size_t size);
+int open_psi_trigger(const char *cgroup_dir, const char *name,
+		     const char *trigger);
 int write_proc_file(pid_t pid, const char *content, const char *basename);
+int read_proc_start_time(pid_t pid, uint64_t *start_time);
 
 int setup_mount_destination(const char *source, const char *dest, uid_t uid,
 			    uid_t gid);
@@ -5,12 +5,15 @@
 
 #include "util.h"
 
+#include <arpa/inet.h>
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>
+#include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include "libconstants.h"
 #include "libsyscalls.h"
@@ -64,6 +67,161 @@ const char *log_syscalls[] = {"connect", "send"};
 
 const size_t log_syscalls_len = ARRAY_SIZE(log_syscalls);
 
+/*
+ * The ring is a fixed array of slots in a shared anonymous mapping, so
+ * children forked after set_log_backend() log into the same ring the
+ * supervisor drains. Writers claim a slot by bumping @head and publish it by
+ * storing its sequence number last; a slot whose sequence number doesn't
+ * match what the reader expects was either overwritten or is still being
+ * written.
+ */
+#define LOG_RING_SLOTS 256
+#define LOG_LINE_MAX 256
+
+struct log_slot {
+	uint64_t seq;
+	char line[LOG_LINE_MAX - sizeof(uint64_t)];
+};
+
+struct log_ring {
+	uint64_t head;
+	struct log_slot slots[LOG_RING_SLOTS];
+};
+
+static enum log_backend log_backend = LOG_TO_SYSLOG;
+static int log_fd = -1;
+static struct log_ring *log_ring;
+static uint64_t log_ring_tail;
+
+int set_log_backend(enum log_backend backend, int fd)
+{
+	switch (backend) {
+	case LOG_TO_SYSLOG:
+		break;
+	case LOG_TO_FD:
+		if (fd < 0)
+			return -EINVAL;
+		log_fd = fd;
+		break;
+	case LOG_TO_RING:
+		if (!log_ring) {
+			void *ring = mmap(NULL, sizeof(*log_ring),
+					  PROT_READ | PROT_WRITE,
+					  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+			if (ring == MAP_FAILED)
+				return -errno;
+			log_ring = ring;
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+	log_backend = backend;
+	return 0;
+}
+
+/* Returns the fd the fd backend writes to, or -1 for the other backends. */
+int log_backend_fd(void)
+{
+	return log_backend == LOG_TO_FD ? log_fd : -1;
+}
+
+static void log_ring_write(const char *line, size_t len)
+{
+	uint64_t idx = __atomic_fetch_add(&log_ring->head, 1, __ATOMIC_RELAXED);
+	struct log_slot *slot = &log_ring->slots[idx % LOG_RING_SLOTS];
+
+	if (len >= sizeof(slot->line))
+		len = sizeof(slot->line) - 1;
+	__atomic_store_n(&slot->seq, 0, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	memcpy(slot->line, line, len);
+	slot->line[len] = '\0';
+	__atomic_store_n(&slot->seq, idx + 1, __ATOMIC_RELEASE);
+}
+
+ssize_t drain_log_ring(char *buf, size_t size)
+{
+	char line[sizeof(log_ring->slots[0].line)];
+	uint64_t head;
+	size_t used = 0;
+
+	if (!log_ring)
+		return -EINVAL;
+
+	head = __atomic_load_n(&log_ring->head, __ATOMIC_ACQUIRE);
+	if (head - log_ring_tail > LOG_RING_SLOTS)
+		log_ring_tail = head - LOG_RING_SLOTS;
+
+	while (log_ring_tail < head) {
+		struct log_slot *slot =
+		    &log_ring->slots[log_ring_tail % LOG_RING_SLOTS];
+		uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		size_t len;
+
+		if (seq < log_ring_tail + 1)
+			break; /* Still being written. */
+		if (seq > log_ring_tail + 1) {
+			log_ring_tail++; /* Lapped by writers. */
+			continue;
+		}
+		memcpy(line, slot->line, sizeof(line));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq) {
+			log_ring_tail++;
+			continue;
+		}
+		line[sizeof(line) - 1] = '\0';
+		len = strlen(line);
+		if (used + len + 1 > size)
+			break;
+		memcpy(buf + used, line, len);
+		buf[used + len] = '\n';
+		used += len + 1;
+		log_ring_tail++;
+	}
+	return used;
+}
+
+void do_log(int priority, const char *format, ...)
+{
+	char line[LOG_LINE_MAX];
+	int saved_errno = errno;
+	va_list ap;
+	int len, ret;
+
+	va_start(ap, format);
+	if (log_backend == LOG_TO_SYSLOG) {
+		vsyslog(priority, format, ap);
+		va_end(ap);
+		errno = saved_errno;
+		return;
+	}
+
+	/*
+	 * Lines start with the "<priority>" prefix that journald and
+	 * syslog-style collectors understand on stream input.
+	 */
+	len = snprintf(line, sizeof(line), "<%d>", LOG_PRI(priority));
+	errno = saved_errno;
+	ret = vsnprintf(line + len, sizeof(line) - len, format, ap);
+	va_end(ap);
+	if (ret > 0)
+		len += ret;
+	if (len > (int)sizeof(line) - 2)
+		len = sizeof(line) - 2;
+
+	if (log_backend == LOG_TO_RING) {
+		log_ring_write(line, len);
+	} else {
+		line[len++] = '\n';
+		if (write(log_fd, line, len) < 0) {
+			/* Nowhere left to report it. */
+		}
+	}
+	errno = saved_errno;
+}
+
 int lookup_syscall(const char *name)
 {
 	const struct syscall_entry *entry = syscall_table;
@@ -73,6 +231,85 @@ int lookup_syscall(const char *name)
 	return -1;
 }
 
+/*
+ * Cheap hash for syscall names: their length, first two and last three
+ * characters tell nearly all of them apart, and strcmp() settles the rest.
+ */
+static size_t hash_name(const char *name)
+{
+	size_t len = strlen(name), hash = len;
+
+	if (len >= 3) {
+		hash = hash * 31 + (unsigned char)name[len - 3];
+		hash = hash * 31 + (unsigned char)name[len - 2];
+	}
+	if (len >= 1) {
+		hash = hash * 31 + (unsigned char)name[0];
+		hash = hash * 31 + (unsigned char)name[len / 2];
+		hash = hash * 31 + (unsigned char)name[len - 1];
+	}
+	return hash ^ (hash >> 7);
+}
+
+/*
+ * lookup_syscalls: looks up all of the @count names in @names in a single pass
+ * over the syscall table, and stores their numbers in @nrs, or -1 for unknown
+ * names. Returns how many were found, or -ENOMEM.
+ */
+ssize_t lookup_syscalls(const char *const *names, size_t count, int *nrs)
+{
+	const struct syscall_entry *entry = syscall_table;
+	size_t size = 16, mask, i;
+	ssize_t found = 0;
+	int *slots;
+
+	while (size < 2 * count)
+		size *= 2;
+	mask = size - 1;
+	slots = malloc(size * sizeof(*slots));
+	if (!slots)
+		return -ENOMEM;
+	for (i = 0; i < size; i++)
+		slots[i] = -1;
+	for (i = 0; i < count; i++) {
+		size_t slot = hash_name(names[i]) & mask;
+
+		nrs[i] = -1;
+		for (; slots[slot] >= 0; slot = (slot + 1) & mask) {
+			/* Repeated names point at the first copy. */
+			if (!strcmp(names[slots[slot]], names[i])) {
+				nrs[i] = -2 - slots[slot];
+				break;
+			}
+		}
+		if (nrs[i] == -1)
+			slots[slot] = i;
+	}
+
+	for (; entry->name && entry->nr >= 0; ++entry) {
+		size_t slot = hash_name(entry->name) & mask;
+
+		for (; slots[slot] >= 0; slot = (slot + 1) & mask) {
+			int idx = slots[slot];
+			/* Like lookup_syscall(), the first entry wins. */
+			if (nrs[idx] < 0 && !strcmp(names[idx], entry->name)) {
+				nrs[idx] = entry->nr;
+				found++;
+				break;
+			}
+		}
+	}
+	for (i = 0; i < count; i++) {
+		if (nrs[i] < -1) {
+			nrs[i] = nrs[-2 - nrs[i]];
+			if (nrs[i] >= 0)
+				found++;
+		}
+	}
+	free(slots);
+	return found;
+}
+
 const char *lookup_syscall_name(int nr)
 {
 	const struct syscall_entry *entry = syscall_table;
@@ -205,6 +442,162 @@ int parse_size(size_t *result, const char *sizespec)
 	return 0;
 }
 
+/*
+ * parse_bitmap_list, specified as a comma-separated list of ids and inclusive
+ * ranges like "0-3,8,10-11", as used for cpuset(7) lists.
+ * Sets the bits for those ids in @mask, which holds @nbits bits.
+ *
+ * Returns 0 on success, -EINVAL on malformed lists, -ERANGE for ids that don't
+ * fit in @mask. Only writes to @mask on success.
+ */
+int parse_bitmap_list(unsigned long *mask, size_t nbits, const char *list)
+{
+	const size_t bits_per_long = 8 * sizeof(*mask);
+	const size_t nlongs = (nbits + bits_per_long - 1) / bits_per_long;
+	unsigned long *parsed;
+	const char *pos = list;
+	char *end;
+
+	if (*list == '\0')
+		return -EINVAL;
+	parsed = calloc(nlongs, sizeof(*parsed));
+	if (!parsed)
+		return -ENOMEM;
+
+	while (*pos) {
+		unsigned long first, last, id;
+
+		if (!isdigit(*pos))
+			goto invalid;
+		first = strtoul(pos, &end, 10);
+		last = first;
+		if (*end == '-') {
+			pos = end + 1;
+			if (!isdigit(*pos))
+				goto invalid;
+			last = strtoul(pos, &end, 10);
+		}
+		if (last < first)
+			goto invalid;
+		if (last >= nbits) {
+			free(parsed);
+			return -ERANGE;
+		}
+		for (id = first; id <= last; ++id)
+			parsed[id / bits_per_long] |= 1UL << (id % bits_per_long);
+
+		if (*end == ',' && end[1] != '\0')
+			pos = end + 1;
+		else if (*end == '\0')
+			pos = end;
+		else
+			goto invalid;
+	}
+
+	memcpy(mask, parsed, nlongs * sizeof(*mask));
+	free(parsed);
+	return 0;
+
+invalid:
+	free(parsed);
+	return -EINVAL;
+}
+
+/*
+ * format_bitmap_list: the inverse of parse_bitmap_list(), writes the set bits
+ * of @mask, which holds @nbits bits, into @buf as a list like "0-3,8".
+ *
+ * Returns 0 on success, -ENOSPC if @buf is too small.
+ */
+int format_bitmap_list(char *buf, size_t size, const unsigned long *mask,
+		       size_t nbits)
+{
+	const size_t bits_per_long = 8 * sizeof(*mask);
+	size_t used = 0;
+	size_t id = 0;
+
+	if (size == 0)
+		return -ENOSPC;
+	buf[0] = '\0';
+	while (id < nbits) {
+		size_t first;
+		int ret;
+
+		if (!(mask[id / bits_per_long] & (1UL << (id % bits_per_long)))) {
+			id++;
+			continue;
+		}
+		first = id;
+		while (id + 1 < nbits && (mask[(id + 1) / bits_per_long] &
+					  (1UL << ((id + 1) % bits_per_long))))
+			id++;
+		if (first == id)
+			ret = snprintf(buf + used, size - used, "%s%zu",
+				       used ? "," : "", first);
+		else
+			ret = snprintf(buf + used, size - used, "%s%zu-%zu",
+				       used ? "," : "", first, id);
+		if (ret < 0 || (size_t)ret >= size - used)
+			return -ENOSPC;
+		used += ret;
+		id++;
+	}
+	return 0;
+}
+
+/*
+ * parse_ipv4_prefix: parses an IPv4 address with a prefix length, like
+ * "10.0.0.1/24". The prefix length is required.
+ *
+ * Returns 0 on success, -EINVAL otherwise.
+ */
+int parse_ipv4_prefix(const char *str, struct in_addr *addr, int *prefixlen)
+{
+	char buf[INET_ADDRSTRLEN];
+	const char *slash = strchr(str, '/');
+	char *end;
+	long len;
+
+	if (!slash || (size_t)(slash - str) >= sizeof(buf))
+		return -EINVAL;
+	memcpy(buf, str, slash - str);
+	buf[slash - str] = '\0';
+	if (inet_pton(AF_INET, buf, addr) != 1)
+		return -EINVAL;
+
+	if (!isdigit((unsigned char)slash[1]))
+		return -EINVAL;
+	errno = 0;
+	len = strtol(slash + 1, &end, 10);
+	if (errno || end == slash + 1 || *end || len < 0 || len > 32)
+		return -EINVAL;
+	*prefixlen = len;
+	return 0;
+}
+
+/*
+ * is_ready_notification: returns 1 if the sd_notify(3) message @msg, a list of
+ * newline-separated assignments that needn't be NUL-terminated, has READY=1.
+ */
+int is_ready_notification(const char *msg, size_t len)
+{
+	static const char ready[] = "READY=1";
+	const size_t ready_len = sizeof(ready) - 1;
+	const char *end = msg + len;
+
+	while (msg < end) {
+		const char *eol = memchr(msg, '\n', end - msg);
+		size_t line_len = (eol ? eol : end) - msg;
+
+		if (line_len == ready_len && !memcmp(msg, ready, ready_len))
+			return 1;
+		if (!eol)
+			break;
+		msg = eol + 1;
+	}
+	return 0;
+}
+
 char *strip(char *s)
 {
 	char *end;
@@ -280,6 +673,40 @@ char *path_join(const char *external_path, const char *internal_path)
 	return path;
 }
 
+/*
+ * Returns the part of @path below @parent, starting with '/' or empty when
+ * the two are the same, or NULL when @path is not @parent or a descendant.
+ */
+const char *path_under(const char *parent, const char *path)
+{
+	size_t len = strlen(parent);
+
+	while (len > 0 && parent[len - 1] == '/')
+		len--;
+	if (strncmp(parent, path, len))
+		return NULL;
+	if (path[len] != '\0' && path[len] != '/')
+		return NULL;
+	return path + len;
+}
+
+/* Returns the number of non-empty components in @path. */
+size_t path_depth(const char *path)
+{
+	size_t depth = 0;
+
+	while (*path) {
+		while (*path == '/')
+			path++;
+		if (!*path)
+			break;
+		depth++;
+		while (*path && *path != '/')
+			path++;
+	}
+	return depth;
+}
+
 void *consumebytes(size_t length, char **buf, size_t *buflength)
 {
 	char *p = *buf;
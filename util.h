@@ -9,6 +9,7 @@
 #ifndef _UTIL_H_
 #define _UTIL_H_
 
+#include <netinet/in.h>
 #include <stdlib.h>
 #include <sys/types.h>
 #include <syslog.h>
@@ -20,7 +21,7 @@ extern "C" {
 
 /* clang-format off */
 #define die(_msg, ...) do { \
-	syslog(LOG_ERR, "libminijail[%d]: " _msg, getpid(), ## __VA_ARGS__); \
+	do_log(LOG_ERR, "libminijail[%d]: " _msg, getpid(), ## __VA_ARGS__); \
 	abort(); \
 } while (0)
 
@@ -28,13 +29,13 @@ extern "C" {
 	die(_msg ": %m", ## __VA_ARGS__)
 
 #define warn(_msg, ...) \
-	syslog(LOG_WARNING, "libminijail[%d]: " _msg, getpid(), ## __VA_ARGS__)
+	do_log(LOG_WARNING, "libminijail[%d]: " _msg, getpid(), ## __VA_ARGS__)
 
 #define pwarn(_msg, ...) \
 	warn(_msg ": %m", ## __VA_ARGS__)
 
 #define info(_msg, ...) \
-	syslog(LOG_INFO, "libminijail[%d]: " _msg, getpid(), ## __VA_ARGS__)
+	do_log(LOG_INFO, "libminijail[%d]: " _msg, getpid(), ## __VA_ARGS__)
 
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 /* clang-format on */
@@ -42,6 +43,24 @@ extern "C" {
 extern const char *log_syscalls[];
 extern const size_t log_syscalls_len;
 
+/*
+ * Where die(), warn() and info() send their messages. Only the syslog
+ * backend allocates or takes locks; the fd and ring backends format into a
+ * stack buffer and finish with a single write(2) or a few atomic stores, so
+ * they are safe to use between fork() and exec() and in signal handlers.
+ */
+enum log_backend {
+	LOG_TO_SYSLOG = 0,
+	LOG_TO_FD,
+	LOG_TO_RING,
+};
+
+void do_log(int priority, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+int set_log_backend(enum log_backend backend, int fd);
+int log_backend_fd(void);
+ssize_t drain_log_ring(char *buf, size_t size);
+
 static inline int is_android()
 {
 #if defined(__ANDROID__)
@@ -59,15 +78,23 @@ static inline int running_with_asan()
 }
 
 int lookup_syscall(const char *name);
+ssize_t lookup_syscalls(const char *const *names, size_t count, int *nrs);
 const char *lookup_syscall_name(int nr);
 
 long int parse_constant(char *constant_str, char **endptr);
 int parse_size(size_t *size, const char *sizespec);
+int parse_bitmap_list(unsigned long *mask, size_t nbits, const char *list);
+int format_bitmap_list(char *buf, size_t size, const unsigned long *mask,
+		       size_t nbits);
+int parse_ipv4_prefix(const char *str, struct in_addr *addr, int *prefixlen);
+int is_ready_notification(const char *msg, size_t len);
 
 char *strip(char *s);
 char *tokenize(char **stringp, const char *delim);
 
 char *path_join(const char *external_path, const char *internal_path);
+const char *path_under(const char *parent, const char *path);
+size_t path_depth(const char *path);
 
 /*
  * consumebytes: consumes @length bytes from a buffer @buf of length @buflength